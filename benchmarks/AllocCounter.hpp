@@ -0,0 +1,32 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+// allocation counting for the benchmarks: replaces the global operator new/delete, so include it
+// from one file per program. every allocation in the process goes through here, the library's and
+// the standard containers' alike.
+inline std::atomic<size_t> g_allocations{0};
+inline std::atomic<size_t> g_bytes{0};
+
+namespace AllocCounter {
+    // kept out of line: inlined into a caller, gcc sees a pointer from operator new reach free()
+    // and warns (-Wmismatched-new-delete)
+    [[gnu::noinline]] inline void* allocate(std::size_t size) {
+        g_allocations.fetch_add(1, std::memory_order_relaxed);
+        g_bytes.fetch_add(size, std::memory_order_relaxed);
+        if (void* p = std::malloc(size ? size : 1)) return p;
+        throw std::bad_alloc();
+    }
+
+    [[gnu::noinline]] inline void release(void* p) noexcept { std::free(p); }
+}
+
+void* operator new(std::size_t size) { return AllocCounter::allocate(size); }
+void* operator new[](std::size_t size) { return AllocCounter::allocate(size); }
+void operator delete(void* p) noexcept { AllocCounter::release(p); }
+void operator delete[](void* p) noexcept { AllocCounter::release(p); }
+void operator delete(void* p, std::size_t) noexcept { AllocCounter::release(p); }
+void operator delete[](void* p, std::size_t) noexcept { AllocCounter::release(p); }
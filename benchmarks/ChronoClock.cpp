@@ -0,0 +1,51 @@
+// MF::Chrono::Clock benchmark
+// cost of reading the time: std::chrono clocks, time(nullptr), the coarse kernel clocks, and
+// Clock::Now with the ticker running; then the local "HH:MM:SS" of a log line, formatted each call
+// (TimeFormat) against Clock::TimeText, which formats once per second.
+//
+// g++ -std=c++17 -O2 -pthread -I../include ChronoClock.cpp -o chrono_clock
+// ./chrono_clock [rounds]
+
+#include "../include/Internal/Time&Date/Clock/Clock.hpp"
+#include <cstdio>
+#include <cstdlib>
+
+using namespace MF::Chrono;
+
+template <typename Fn>
+static double nsPer(size_t n, Fn fn) {
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < n; ++i) fn();
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()) / static_cast<double>(n);
+}
+
+int main(int argc, char* argv[]) {
+    size_t rounds = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 2000000;
+    std::int64_t sink = 0;
+    char buffer[32];
+
+    std::printf("%zu reads; resolution: realtime %lld ns, coarse %lld ns\n", rounds,
+                static_cast<long long>(Clock::Resolution(Clock::Kind::Realtime)),
+                static_cast<long long>(Clock::Resolution(Clock::Kind::RealtimeCoarse)));
+    std::printf("%-34s %8.1f ns\n", "system_clock::now", nsPer(rounds, [&] { sink += std::chrono::system_clock::now().time_since_epoch().count(); }));
+    std::printf("%-34s %8.1f ns\n", "steady_clock::now", nsPer(rounds, [&] { sink += std::chrono::steady_clock::now().time_since_epoch().count(); }));
+    std::printf("%-34s %8.1f ns\n", "time(nullptr)", nsPer(rounds, [&] { sink += std::time(nullptr); }));
+    std::printf("%-34s %8.1f ns\n", "Clock::RealtimeCoarse", nsPer(rounds, [&] { sink += Clock::RealtimeCoarse().seconds; }));
+    std::printf("%-34s %8.1f ns\n", "Clock::MonotonicCoarse", nsPer(rounds, [&] { sink += Clock::MonotonicCoarse(); }));
+
+    static const TimeFormat clock("%H:%M:%S");
+    std::printf("%-34s %8.1f ns\n", "HH:MM:SS  time + TimeFormat", nsPer(rounds, [&] {
+        sink += clock.FormatTo(buffer, buffer + sizeof(buffer), Timestamp{static_cast<std::int64_t>(std::time(nullptr)), 0}).ptr - buffer;
+    }));
+    std::printf("%-34s %8.1f ns\n", "HH:MM:SS  Clock::TimeText", nsPer(rounds, [&] { sink += static_cast<std::int64_t>(Clock::TimeText(buffer)); }));
+
+    Clock::StartTicker();
+    std::printf("ticker running, 1 ms interval\n");
+    std::printf("%-34s %8.1f ns\n", "Clock::Now", nsPer(rounds, [&] { sink += Clock::Now().seconds; }));
+    std::printf("%-34s %8.1f ns\n", "Clock::MonotonicNow", nsPer(rounds, [&] { sink += Clock::MonotonicNow(); }));
+    std::printf("%-34s %8.1f ns\n", "HH:MM:SS  Clock::TimeText", nsPer(rounds, [&] { sink += static_cast<std::int64_t>(Clock::TimeText(buffer)); }));
+    Clock::StopTicker();
+    std::printf("(%lld)\n", static_cast<long long>(sink % 10));
+    return 0;
+}
@@ -0,0 +1,89 @@
+// MF::Chrono::TimeFormat benchmark
+// cost of one timestamp: the old GetTimeStr (localtime_r + ostringstream with setw/setfill),
+// localtime_r + strftime, and a compiled TimeFormat writing into a stack buffer, for "HH:MM:SS"
+// and for ISO 8601 with microseconds and offset. then reading ISO 8601 back: strptime + timegm
+// against TimeFormat::Parse.
+//
+// g++ -std=c++17 -O2 -I../include ChronoFormat.cpp -o chrono_format
+// ./chrono_format [rounds]
+
+#include "../include/Internal/Time&Date/Time/Misc.hpp"
+#include "../include/Internal/Time&Date/Misc.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <iomanip>
+#include <sstream>
+#include <vector>
+
+using namespace MF::Chrono;
+
+// GetTimeStr as it was
+static std::string legacyTimeStr(std::time_t t) {
+    std::tm tm_local;
+    localtime_r(&t, &tm_local);
+    std::ostringstream oss;
+    oss << std::setw(2) << std::setfill('0') << tm_local.tm_hour << ":"
+        << std::setw(2) << std::setfill('0') << tm_local.tm_min << ":"
+        << std::setw(2) << std::setfill('0') << tm_local.tm_sec;
+    return oss.str();
+}
+
+template <typename Fn>
+static double nsPer(size_t n, Fn fn) {
+    ::Time::Timer timer(::Time::Timer::Precision::Nanoseconds);
+    timer.start();
+    for (size_t i = 0; i < n; ++i) fn(i);
+    timer.stop();
+    return timer.elapsed() / static_cast<double>(n);
+}
+
+int main(int argc, char* argv[]) {
+    size_t rounds = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+    std::time_t base = std::time(nullptr);
+    size_t sink = 0;
+    char buffer[128];
+
+    const TimeFormat clock("%H:%M:%S");
+    const TimeFormat iso("%Y-%m-%dT%H:%M:%S.%6f%z");
+    std::printf("%zu timestamps, consecutive seconds from now\n", rounds);
+    std::printf("%-34s %8.1f ns\n", "HH:MM:SS  old GetTimeStr", nsPer(rounds, [&](size_t i) { sink += legacyTimeStr(base + static_cast<std::time_t>(i)).size(); }));
+    std::printf("%-34s %8.1f ns\n", "HH:MM:SS  localtime_r + strftime", nsPer(rounds, [&](size_t i) {
+        std::time_t t = base + static_cast<std::time_t>(i);
+        std::tm tm_local;
+        localtime_r(&t, &tm_local);
+        sink += std::strftime(buffer, sizeof(buffer), "%H:%M:%S", &tm_local);
+    }));
+    std::printf("%-34s %8.1f ns\n", "HH:MM:SS  TimeFormat::FormatTo", nsPer(rounds, [&](size_t i) {
+        sink += static_cast<size_t>(clock.FormatTo(buffer, buffer + sizeof(buffer), Timestamp{static_cast<std::int64_t>(base) + static_cast<std::int64_t>(i), 0}).ptr - buffer);
+    }));
+    std::printf("%-34s %8.1f ns\n", "HH:MM:SS  new GetTimeStr", nsPer(rounds, [&](size_t) { sink += MF::Chrono::Time::GetTimeStr().size(); }));
+
+    std::printf("%-34s %8.1f ns\n", "ISO 8601  localtime_r + strftime", nsPer(rounds, [&](size_t i) {
+        std::time_t t = base + static_cast<std::time_t>(i);
+        std::tm tm_local;
+        localtime_r(&t, &tm_local);
+        size_t n = std::strftime(buffer, sizeof(buffer), "%Y-%m-%dT%H:%M:%S", &tm_local);
+        n += static_cast<size_t>(std::snprintf(buffer + n, sizeof(buffer) - n, ".%06u", static_cast<unsigned>(i % 1000000)));
+        sink += n + std::strftime(buffer + n, sizeof(buffer) - n, "%z", &tm_local);
+    }));
+    std::printf("%-34s %8.1f ns\n", "ISO 8601  TimeFormat::FormatTo", nsPer(rounds, [&](size_t i) {
+        Timestamp ts{static_cast<std::int64_t>(base) + static_cast<std::int64_t>(i), static_cast<std::uint32_t>(i % 1000000) * 1000};
+        sink += static_cast<size_t>(iso.FormatTo(buffer, buffer + sizeof(buffer), ts).ptr - buffer);
+    }));
+
+    std::vector<std::string> texts;
+    const TimeFormat isoUtc("%Y-%m-%dT%H:%M:%S%z");
+    for (size_t i = 0; i < 1000; ++i) texts.push_back(isoUtc.Format(Timestamp{static_cast<std::int64_t>(base) + static_cast<std::int64_t>(i) * 3607, 0}, Zone::UTC));
+    std::printf("%-34s %8.1f ns\n", "parse     strptime + timegm", nsPer(rounds, [&](size_t i) {
+        std::tm tm{};
+        strptime(texts[i % texts.size()].c_str(), "%Y-%m-%dT%H:%M:%S%z", &tm);
+        sink += static_cast<size_t>(timegm(&tm));
+    }));
+    std::printf("%-34s %8.1f ns\n", "parse     TimeFormat::Parse", nsPer(rounds, [&](size_t i) {
+        auto ts = isoUtc.Parse(texts[i % texts.size()]);
+        sink += ts ? static_cast<size_t>(ts->seconds) : 0;
+    }));
+    std::printf("(%zu)\n", sink % 10);
+    return 0;
+}
@@ -0,0 +1,77 @@
+// FilesManager read benchmark
+// reading a whole file and scanning it once (counting lines), warm page cache: the old
+// ReadFileToString (istreambuf_iterator into a growing string), the fstat-sized single read, and
+// MappedFile with and without MAP_POPULATE. file sizes in MB on the command line, written to the
+// temp directory first and removed afterwards.
+//
+// g++ -std=c++17 -O2 -I../include FilesRead.cpp -o files_read
+// ./files_read [MB...]          (default: 1 16 256; 1024 for the 1 GB case)
+
+#include "../include/Internal/Files/FilesManager.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+using namespace MF;
+
+// ReadFileToString as it was
+static std::optional<std::string> legacyRead(const std::string& Path) {
+    std::ifstream File(fs::u8path(Path), std::ios::binary);
+    if (!File.is_open()) return std::nullopt;
+    return std::string((std::istreambuf_iterator<char>(File)), std::istreambuf_iterator<char>());
+}
+
+static size_t lines(std::string_view Text) { return static_cast<size_t>(std::count(Text.begin(), Text.end(), '\n')); }
+
+// best of `rounds`, in MB/s
+template <typename Fn>
+static double mbPerSecond(size_t bytes, int rounds, size_t& sink, Fn fn) {
+    double best = 1e30;
+    for (int i = 0; i < rounds; ++i) {
+        auto start = std::chrono::steady_clock::now();
+        sink += fn();
+        double s = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        best = std::min(best, s);
+    }
+    return static_cast<double>(bytes) / (1 << 20) / best;
+}
+
+int main(int argc, char* argv[]) {
+    std::vector<size_t> sizes;
+    for (int i = 1; i < argc; ++i) sizes.push_back(std::strtoull(argv[i], nullptr, 10));
+    if (sizes.empty()) sizes = {1, 16, 256};
+
+    std::string path = (fs::temp_directory_path() / "mfwork_files_read.txt").string();
+    size_t sink = 0;
+    std::printf("%8s %12s %12s %12s %12s   (MB/s, best of n)\n", "MB", "old read", "new read", "mmap", "mmap+pop");
+    for (size_t mb : sizes) {
+        {
+            std::string line = "key: value with some text in it, like a config or log line\n";
+            std::ofstream out(path, std::ios::binary | std::ios::trunc);
+            for (size_t written = 0; written < mb << 20; written += line.size()) out << line;
+        }
+        size_t bytes = static_cast<size_t>(*FilesManager::FileSize(path));
+        int rounds = mb >= 256 ? 2 : mb >= 16 ? 5 : 30;
+        double oldRead = mbPerSecond(bytes, mb >= 256 ? 1 : rounds, sink, [&] { return lines(*legacyRead(path)); });
+        double newRead = mbPerSecond(bytes, rounds, sink, [&] { return lines(*FilesManager::ReadFileToString(path)); });
+        double mapped = mbPerSecond(bytes, rounds, sink, [&] {
+            FilesManager::MappedFile::Options options;
+            options.Advice = FilesManager::MappedFile::Access::Sequential;
+            FilesManager::MappedFile file;
+            file.Open(path, options);
+            return lines(file.View());
+        });
+        double populated = mbPerSecond(bytes, rounds, sink, [&] {
+            FilesManager::MappedFile::Options options;
+            options.Populate = true;
+            FilesManager::MappedFile file;
+            file.Open(path, options);
+            return lines(file.View());
+        });
+        std::printf("%8zu %12.0f %12.0f %12.0f %12.0f\n", mb, oldRead, newRead, mapped, populated);
+    }
+    FilesManager::Remove(path);
+    std::printf("(%zu)\n", sink % 10);
+    return 0;
+}
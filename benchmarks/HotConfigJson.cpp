@@ -0,0 +1,86 @@
+// HotConfig JSON benchmark
+// on the same generated data: .hc text parsing vs JSON reading, writeMap vs JSON writing.
+// also checks that a JSON round trip gives back the same tree.
+//
+// g++ -std=c++17 -O2 -pthread -I../include HotConfigJson.cpp -o hc_json
+// ./hc_json [sections] [rounds]
+
+#include "../include/Internal/Configuration/Json.hpp"
+#include "../include/Internal/Time&Date/Misc.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <sstream>
+#include <string>
+
+using namespace MF::Configurations::Internal::Parser;
+
+static std::string generate(size_t sections) {
+    std::string out;
+    out.reserve(sections * 400);
+    for (size_t s = 0; s < sections; ++s) {
+        out += "# tenant " + std::to_string(s) + "\n";
+        out += "Tenant" + std::to_string(s) + ":\n";
+        out += "    Build:\n";
+        out += "        Version: \"1." + std::to_string(s % 17) + ".0\"\n";
+        out += "        Channel: Production # Developing/Unstable/Beta/Production\n";
+        out += "    Limits:\n";
+        out += "        Requests: " + std::to_string(s * 13) + "\n";
+        out += "        Ratio: 0." + std::to_string(s % 100 + 1) + "\n";
+        out += "        Strict: " + std::string(s % 2 ? "true" : "false") + "\n";
+        out += "    Hosts:\n";
+        for (int i = 0; i < 4; ++i) out += "        - host" + std::to_string(i) + ".tenant" + std::to_string(s) + ".local\n";
+        out += "\n";
+    }
+    return out;
+}
+
+template <typename Fn>
+static double run(int rounds, Fn fn) {
+    Time::Timer timer(Time::Timer::Precision::Milliseconds);
+    timer.start();
+    for (int r = 0; r < rounds; ++r) fn();
+    timer.stop();
+    return timer.elapsed(Time::Timer::Precision::Seconds) / rounds;
+}
+
+static void line(const char* name, double seconds, size_t bytes) {
+    std::printf("%-18s %10.3f ms %10.2f MiB/s\n", name, seconds * 1000.0,
+                static_cast<double>(bytes) / (1024.0 * 1024.0) / seconds);
+}
+
+int main(int argc, char* argv[]) {
+    size_t sections = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 5000;
+    int rounds = argc > 2 ? std::atoi(argv[2]) : 5;
+
+    std::string text = generate(sections);
+    HotConfig cfg;
+    if (!cfg.parseBuffer(text)) {
+        std::printf("generated document doesn't parse\n");
+        return 1;
+    }
+    std::string json = toJson(cfg.root);
+    std::printf("input: %zu sections, .hc %.2f MiB, json %.2f MiB, %d rounds\n", sections,
+                static_cast<double>(text.size()) / (1024.0 * 1024.0), static_cast<double>(json.size()) / (1024.0 * 1024.0), rounds);
+
+    HCMap parsed;
+    bool ok = fromJson(json, parsed);
+    bool identical = ok && toJson(parsed) == json;
+    std::printf("round trip: %s\n", identical ? "identical" : "MISMATCH");
+    if (!identical) return 1;
+
+    HotConfig scratch;
+    line("hc parseBuffer", run(rounds, [&] { scratch.parseBuffer(text); }), text.size());
+    line("json read", run(rounds, [&] { fromJson(json, parsed); }), json.size());
+
+    std::string written;
+    line("hc writeMap", run(rounds, [&] {
+        std::ostringstream os;
+        cfg.writeMap(os, cfg.root);
+        written = os.str();
+    }), text.size());
+    line("json write", run(rounds, [&] {
+        written.clear();
+        toJson(cfg.root, written);
+    }), json.size());
+    return 0;
+}
@@ -0,0 +1,108 @@
+// HotConfig large list benchmark
+// parses documents holding one big list of ints, doubles or strings, then sums them through
+// ConfigManager::TryGetList (an HCValue per element) and through the contiguous views
+// (TryGetInts/TryGetDoubles/TryGetStrings). a list with a comment in it can't be stored compactly,
+// so the same list with one comment on top gives the per-element numbers to compare with.
+//
+// g++ -std=c++17 -O2 -pthread -I../include HotConfigLists.cpp -o hc_lists
+// ./hc_lists [elements] [rounds]
+
+#include "../include/Internal/Configuration/ConfigManager.hpp"
+#include "../include/Internal/Time&Date/Misc.hpp"
+#include "AllocCounter.hpp"
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+using namespace MF::Configurations;
+using namespace MF::Configurations::Internal::Parser;
+
+static std::string generate(char kind, size_t n, bool comment) {
+    std::string out = "Values:\n";
+    out.reserve(n * 16);
+    if (comment) out += "  # first\n";
+    for (size_t i = 0; i < n; ++i) {
+        out += "  - ";
+        if (kind == 'i') out += std::to_string(static_cast<long long>(i) * 7 - 1000);
+        else if (kind == 'd') out += std::to_string(i) + ".25";
+        else out += "item" + std::to_string(i);
+        out += '\n';
+    }
+    return out;
+}
+
+template <typename Fn>
+static double run(int rounds, Fn fn) {
+    Time::Timer timer(Time::Timer::Precision::Milliseconds);
+    timer.start();
+    for (int r = 0; r < rounds; ++r) fn();
+    timer.stop();
+    return timer.elapsed(Time::Timer::Precision::Seconds) / rounds;
+}
+
+static double sumList(ConfigManager& cfg) {
+    const HCList* list = nullptr;
+    double sum = 0.0;
+    if (!cfg.TryGetList("Values", list)) return sum;
+    for (const auto& item : *list) {
+        double d = 0.0;
+        if (item.tryDouble(d)) sum += d;
+        else sum += static_cast<double>(item.asString().size());
+    }
+    return sum;
+}
+
+static double sumView(ConfigManager& cfg) {
+    double sum = 0.0;
+    HCArrayView<std::int64_t> ints;
+    HCArrayView<double> doubles;
+    HCArrayView<std::string> strings;
+    if (cfg.TryGetInts("Values", ints)) for (auto v : ints) sum += static_cast<double>(v);
+    else if (cfg.TryGetDoubles("Values", doubles)) for (auto v : doubles) sum += v;
+    else if (cfg.TryGetStrings("Values", strings)) for (const auto& v : strings) sum += static_cast<double>(v.size());
+    return sum;
+}
+
+int main(int argc, char* argv[]) {
+    size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 200000;
+    int rounds = argc > 2 ? std::atoi(argv[2]) : 5;
+    std::string path = (std::filesystem::temp_directory_path() / "hc_lists.hc").string();
+
+    std::printf("%zu elements, %d rounds\n", n, rounds);
+    std::printf("%-8s %-8s %10s %12s %12s %10s %10s\n", "type", "storage", "parse ms", "allocs", "MiB alloc", "list ms", "view ms");
+    for (char kind : {'i', 'd', 's'}) {
+        for (bool comment : {true, false}) {
+            std::string text = generate(kind, n, comment);
+            {
+                std::ofstream file(path);
+                file << text;
+            }
+
+            HotConfig scratch;
+            size_t allocs = g_allocations.load(), bytes = g_bytes.load();
+            scratch.parseBuffer(text);
+            allocs = g_allocations.load() - allocs;
+            bytes = g_bytes.load() - bytes;
+            double parse = run(rounds, [&] { scratch.parseBuffer(text); });
+
+            ConfigManager cfg;
+            if (!cfg.Load(path)) {
+                std::printf("generated document doesn't load\n");
+                return 1;
+            }
+            volatile double sink = 0.0;
+            double listTime = run(rounds, [&] { sink = sink + sumList(cfg); });
+            const char* storage = cfg.Configuration.get("Values")->isArray() ? "compact" : "values";
+            double viewTime = run(rounds, [&] { sink = sink + sumView(cfg); });
+
+            std::printf("%-8s %-8s %10.3f %12zu %12.2f %10.3f %10s\n", kind == 'i' ? "int" : kind == 'd' ? "double" : "string",
+                        storage, parse * 1000.0, allocs, static_cast<double>(bytes) / (1024.0 * 1024.0), listTime * 1000.0,
+                        comment ? "-" : std::to_string(viewTime * 1000.0).c_str());
+        }
+    }
+    std::filesystem::remove(path);
+    return 0;
+}
@@ -0,0 +1,71 @@
+// HotConfig parallel parsing benchmark
+// compares HotConfig::parseBuffer with HotConfig::parseParallel on 1..N threads
+//
+// g++ -std=c++17 -O2 -pthread -I../include HotConfigParallel.cpp -o hc_parallel
+// ./hc_parallel [sections] [maxThreads]
+
+#include "../include/Internal/Configuration/Parser.hpp"
+#include "../include/Internal/Time&Date/Misc.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <sstream>
+#include <string>
+#include <thread>
+
+using MF::Configurations::Internal::Parser::HotConfig;
+
+static std::string generate(size_t sections) {
+    std::string out;
+    out.reserve(sections * 400);
+    for (size_t s = 0; s < sections; ++s) {
+        out += "# tenant " + std::to_string(s) + "\n";
+        out += "Tenant" + std::to_string(s) + ":\n";
+        out += "    Build:\n";
+        out += "        Version: 1." + std::to_string(s % 17) + ".0\n";
+        out += "        Channel: Production # Developing/Unstable/Beta/Production\n";
+        out += "    Limits:\n";
+        out += "        Requests: " + std::to_string(s * 13) + "\n";
+        out += "        Ratio: 0." + std::to_string(s % 100) + "\n";
+        out += "        Strict: " + std::string(s % 2 ? "true" : "false") + "\n";
+        out += "    Hosts:\n";
+        for (int i = 0; i < 4; ++i) out += "        - host" + std::to_string(i) + ".tenant" + std::to_string(s) + ".local\n";
+        out += "\n";
+    }
+    return out;
+}
+
+static std::string dump(const HotConfig& cfg) {
+    std::ostringstream os;
+    cfg.writeMap(os, cfg.root);
+    return os.str();
+}
+
+int main(int argc, char* argv[]) {
+    size_t sections = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 5000;
+    unsigned maxThreads = argc > 2 ? static_cast<unsigned>(std::strtoul(argv[2], nullptr, 10))
+                                   : std::max(1u, std::thread::hardware_concurrency());
+
+    std::string text = generate(sections);
+    double mb = static_cast<double>(text.size()) / (1024.0 * 1024.0);
+    std::printf("input: %zu sections, %.2f MiB\n", sections, mb);
+
+    HotConfig reference;
+    Time::Timer timer(Time::Timer::Precision::Milliseconds);
+    timer.start();
+    bool ok = reference.parseBuffer(text);
+    timer.stop();
+    std::printf("%-12s %10.3f ms %10.2f MiB/s %s\n", "sequential", timer.elapsed(), mb / (timer.elapsed() / 1000.0), ok ? "" : "(failed)");
+    std::string expected = dump(reference);
+
+    for (unsigned t = 1; t <= maxThreads; ++t) {
+        HotConfig cfg;
+        timer.restart();
+        ok = cfg.parseParallel(text, t);
+        timer.stop();
+        bool identical = ok && dump(cfg) == expected;
+        std::printf("threads=%-4u %10.3f ms %10.2f MiB/s %s\n", t, timer.elapsed(), mb / (timer.elapsed() / 1000.0),
+                    identical ? "identical" : "MISMATCH");
+        if (!identical) return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,87 @@
+// HotConfig line scanner benchmark
+// reports scanLine throughput for every ISA the CPU supports and checks they agree with the scalar scan
+//
+// g++ -std=c++17 -O2 -I../include HotConfigScanner.cpp -o hc_scanner
+// ./hc_scanner [lines] [rounds]
+
+#include "../include/Internal/Configuration/Scanner.hpp"
+#include "../include/Internal/Time&Date/Misc.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+using namespace MF::Configurations::Internal::Parser;
+
+static std::string generate(size_t lines) {
+    static const char* samples[] = {
+        "Printing:",
+        "    CurrentLogLevel: Debug",
+        "        Channel: Developing # Developing/Unstable/Beta/Production",
+        "            - x86_64",
+        "                # arm64",
+        "    Motd: \"Welcome: it's # not a comment\" # but this is",
+        "    Path: '/srv/data:/srv/cache'",
+        "        LongDescription: a fairly long value that spans well past one sixty-four byte block of input text",
+        "",
+    };
+    const size_t count = sizeof(samples) / sizeof(samples[0]);
+    std::string out;
+    for (size_t i = 0; i < lines; ++i) {
+        out += samples[(i * 7) % count];
+        out += '\n';
+    }
+    return out;
+}
+
+static size_t scanAll(std::string_view text, ScanISA isa, std::vector<LineInfo>* out) {
+    size_t checksum = 0, pos = 0;
+    while (pos < text.size()) {
+        LineInfo info = scanLine(text.substr(pos), isa);
+        checksum += info.indent + info.contentEnd + (info.colon != std::string::npos) + (info.comment != std::string::npos);
+        if (out) out->push_back(info);
+        pos += info.length + 1;
+    }
+    return checksum;
+}
+
+static bool same(const LineInfo& a, const LineInfo& b) {
+    return a.length == b.length && a.indent == b.indent && a.comment == b.comment &&
+           a.colon == b.colon && a.contentEnd == b.contentEnd;
+}
+
+int main(int argc, char* argv[]) {
+    size_t lines = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+    int rounds = argc > 2 ? std::atoi(argv[2]) : 5;
+
+    std::string text = generate(lines);
+    double mb = static_cast<double>(text.size()) / (1024.0 * 1024.0);
+    std::printf("input: %zu lines, %.2f MiB, %d rounds\n", lines, mb, rounds);
+
+    std::vector<LineInfo> expected;
+    scanAll(text, ScanISA::Scalar, &expected);
+
+    for (ScanISA isa : {ScanISA::Scalar, ScanISA::SSE2, ScanISA::AVX2}) {
+        if (!ScanISASupported(isa)) {
+            std::printf("%-8s unsupported\n", ScanISAName(isa));
+            continue;
+        }
+
+        std::vector<LineInfo> got;
+        scanAll(text, isa, &got);
+        bool identical = got.size() == expected.size();
+        for (size_t i = 0; identical && i < got.size(); ++i) identical = same(got[i], expected[i]);
+
+        size_t checksum = 0;
+        Time::Timer timer(Time::Timer::Precision::Milliseconds);
+        timer.start();
+        for (int r = 0; r < rounds; ++r) checksum += scanAll(text, isa, nullptr);
+        timer.stop();
+
+        double seconds = timer.elapsed(Time::Timer::Precision::Seconds);
+        std::printf("%-8s %10.2f MiB/s  %s  (checksum %zu)\n", ScanISAName(isa), mb * rounds / seconds,
+                    identical ? "identical" : "MISMATCH", checksum);
+        if (!identical) return 1;
+    }
+    return 0;
+}
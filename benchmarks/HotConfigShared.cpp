@@ -0,0 +1,153 @@
+// HotConfig shared snapshot benchmark
+// forks worker processes that each need the same config: either every worker parses the file with
+// ConfigManager::Load, or one HCSharedPublisher writes a snapshot to shared memory and the workers
+// attach to it with HCSharedReader. reports the time until every worker has read its keys and the
+// heap each worker ends up using for the config (glibc mallinfo2), then the cost of one lookup.
+//
+// g++ -std=c++17 -O2 -pthread -I../include HotConfigShared.cpp -o hc_shared -lrt
+// ./hc_shared [sections] [workers]
+
+#include "../include/Internal/Configuration/ConfigManager.hpp"
+#include "../include/Internal/Time&Date/Misc.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <malloc.h>
+#include <string>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace MF::Configurations;
+using namespace MF::Configurations::Internal::Parser;
+
+static std::string generate(size_t sections) {
+    std::string out;
+    for (size_t s = 0; s < sections; ++s) {
+        out += "Service" + std::to_string(s) + ":\n";
+        out += "    Host: svc" + std::to_string(s) + ".internal.example.com\n";
+        out += "    Port: " + std::to_string(8000 + s % 1000) + "\n";
+        out += "    Timeout: 2s\n";
+        out += "    Weight: 0." + std::to_string(s % 9 + 1) + "\n";
+        out += "    Enabled: true\n";
+        out += "    Tags:\n        - blue\n        - edge\n";
+    }
+    return out;
+}
+
+static double heapMiB() {
+    return static_cast<double>(mallinfo2().uordblks) / (1024.0 * 1024.0);
+}
+
+static std::string key(size_t i, size_t sections) {
+    return "Service" + std::to_string((i * 7919) % sections) + ".Port";
+}
+
+// runs `workers` processes doing `fn`, which returns a checksum and sets the heap it holds on to
+template <typename Fn>
+static void spawn(const char* name, int workers, Fn fn) {
+    auto* heap = static_cast<double*>(mmap(nullptr, sizeof(double) * workers, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0));
+    Time::Timer timer(Time::Timer::Precision::Milliseconds);
+    timer.start();
+    for (int w = 0; w < workers; ++w) {
+        if (fork() == 0) {
+            long long sum = fn(heap[w]);
+            _exit(sum > 0 ? 0 : 1);
+        }
+    }
+    int failures = 0;
+    for (int w = 0; w < workers; ++w) {
+        int status = 0;
+        wait(&status);
+        failures += !WIFEXITED(status) || WEXITSTATUS(status) != 0;
+    }
+    timer.stop();
+    double total = 0.0;
+    for (int w = 0; w < workers; ++w) total += heap[w];
+    std::printf("%-24s %10.1f ms %12.2f MiB heap/worker%s\n", name, timer.elapsed(), total / workers, failures ? "  (FAILED)" : "");
+    munmap(heap, sizeof(double) * workers);
+}
+
+int main(int argc, char* argv[]) {
+    size_t sections = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 5000;
+    int workers = argc > 2 ? std::atoi(argv[2]) : 32;
+    const size_t reads = 100;
+
+    std::string path = (std::filesystem::temp_directory_path() / "hc_shared.hc").string();
+    MF::FilesManager::WriteStringToFile(path, generate(sections));
+    std::printf("%zu sections, %d workers, %zu reads each\n", sections, workers, reads);
+
+    spawn("ConfigManager::Load", workers, [&](double& heap) {
+        double before = heapMiB();
+        ConfigManager cfg;
+        if (!cfg.Load(path)) return 0LL;
+        long long sum = 0;
+        for (size_t i = 0; i < reads; ++i) sum += cfg.GetInt(key(i, sections));
+        heap = heapMiB() - before;
+        return sum;
+    });
+
+    HCSharedPublisher publisher("/mfwork_hc_shared_bench");
+    Time::Timer timer(Time::Timer::Precision::Milliseconds);
+    std::uint64_t generation = 0;
+    {
+        ConfigManager source;
+        source.Load(path);
+        timer.start();
+        generation = publisher.Publish(source.Configuration.root, 1);
+        timer.stop();
+    }
+    if (!generation) {
+        std::printf("can't publish to shared memory\n");
+        return 1;
+    }
+    std::printf("%-24s %10.1f ms\n", "publish", timer.elapsed());
+
+    spawn("HCSharedReader attach", workers, [&](double& heap) {
+        double before = heapMiB();
+        HCSharedReader reader("/mfwork_hc_shared_bench");
+        if (!reader.Attach()) return 0LL;
+        auto snapshot = reader.Current();
+        if (!snapshot) return 0LL;
+        long long sum = 0;
+        for (size_t i = 0; i < reads; ++i) {
+            std::int64_t port = 0;
+            snapshot->Get(key(i, sections)).tryInt64(port);
+            sum += port;
+        }
+        heap = heapMiB() - before;
+        return sum;
+    });
+
+    // lookups in this process, same keys both ways
+    ConfigManager source;
+    source.Load(path);
+    HCSharedReader reader("/mfwork_hc_shared_bench");
+    reader.Attach();
+    auto snapshot = reader.Current();
+    std::vector<std::string> keys;
+    for (size_t i = 0; i < 1000; ++i) keys.push_back(key(i, sections));
+    const int rounds = 20;
+    long long sink = 0;
+    timer.start();
+    for (int r = 0; r < rounds; ++r)
+        for (const auto& k : keys) sink += source.GetInt(k);
+    timer.stop();
+    double managerNs = timer.elapsed(Time::Timer::Precision::Seconds) * 1e9 / (rounds * keys.size());
+    timer.start();
+    for (int r = 0; r < rounds; ++r) {
+        for (const auto& k : keys) {
+            std::int64_t port = 0;
+            snapshot->Get(k).tryInt64(port);
+            sink += port;
+        }
+    }
+    timer.stop();
+    double snapshotNs = timer.elapsed(Time::Timer::Precision::Seconds) * 1e9 / (rounds * keys.size());
+    std::printf("lookup: ConfigManager::GetInt %.0f ns, snapshot Get %.0f ns (%lld)\n", managerNs, snapshotNs, sink % 10);
+
+    snapshot.reset();
+    publisher.Unlink();
+    std::filesystem::remove(path);
+    return 0;
+}
@@ -0,0 +1,273 @@
+// HotConfig benchmark suite
+// generates a synthetic .hc file and measures loading, lookups, updates, writing and the
+// ConfigManager typed getters. reports throughput, latency percentiles and allocations per op,
+// as a table or as JSON/CSV for tracking regressions between releases.
+//
+// g++ -std=c++17 -O2 -pthread -I../include HotConfigSuite.cpp -o hc_suite
+// ./hc_suite [--depth N] [--width N] [--list N] [--comments 0..1] [--types sidbl]
+//            [--iterations N] [--seed N] [--format text|json|csv] [--keep file.hc]
+//
+// --types picks the scalar kinds to generate: s(tring) i(nt) d(ouble) b(ool) l(ist)
+
+#include "../include/Internal/Configuration/ConfigManager.hpp"
+#include "AllocCounter.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace MF::Configurations;
+using Internal::Parser::HCValue;
+using Internal::Parser::HotConfig;
+
+struct Options {
+    int depth = 3;
+    int width = 8;
+    int listLength = 4;
+    double comments = 0.2;
+    std::string types = "sidbl";
+    size_t iterations = 20000;
+    unsigned seed = 42;
+    std::string format = "text";
+    std::string keep;
+};
+
+// synthetic config: `width` keys per map, `depth` levels of maps, scalars/lists at the leaves
+class Generator {
+public:
+    std::vector<std::string> Scalars;   // dotted paths of scalar leaves
+    std::vector<char> Kinds;            // kind of each of them
+
+    explicit Generator(const Options& opt) : opt_(opt), rng_(opt.seed) {}
+
+    std::string Generate() {
+        std::string out;
+        map(out, 0, "");
+        return out;
+    }
+
+private:
+    const Options& opt_;
+    std::mt19937 rng_;
+
+    bool chance(double p) { return std::uniform_real_distribution<double>(0.0, 1.0)(rng_) < p; }
+
+    std::string scalar(char kind) {
+        switch (kind) {
+            case 'i': return std::to_string(static_cast<int>(rng_() % 100000) - 50000);
+            case 'd': return std::to_string(std::uniform_real_distribution<double>(-1e4, 1e4)(rng_));
+            case 'b': return rng_() % 2 ? "true" : "false";
+            default:  return "value_" + std::to_string(rng_() % 1000000);
+        }
+    }
+
+    void map(std::string& out, int level, const std::string& prefix) {
+        std::string indent(static_cast<size_t>(level) * 4, ' ');
+        for (int i = 0; i < opt_.width; ++i) {
+            std::string key = (level == 0 ? "Section" : "Key") + std::to_string(i);
+            std::string path = prefix.empty() ? key : prefix + "." + key;
+            if (chance(opt_.comments)) out += indent + "# about " + key + "\n";
+
+            if (level + 1 < opt_.depth) {
+                out += indent + key + ":\n";
+                map(out, level + 1, path);
+                continue;
+            }
+
+            char kind = opt_.types[rng_() % opt_.types.size()];
+            if (kind == 'l') {
+                out += indent + key + ":\n";
+                for (int j = 0; j < opt_.listLength; ++j) out += indent + "    - " + scalar('s') + "\n";
+                continue;
+            }
+            out += indent + key + ": " + scalar(kind);
+            if (chance(opt_.comments)) out += " # inline note";
+            out += "\n";
+            Scalars.push_back(path);
+            Kinds.push_back(kind);
+        }
+    }
+};
+
+struct Result {
+    std::string name;
+    size_t ops = 0;
+    double seconds = 0;
+    double p50 = 0, p90 = 0, p99 = 0, max = 0;   // ns per op
+    double allocsPerOp = 0;
+    double bytesPerSecond = 0;                   // for whole-document operations
+};
+
+using Clock = std::chrono::steady_clock;
+
+// runs `op(i)` `ops` times in batches, so the clock overhead stays small next to cheap ops
+template <typename Op>
+static Result measure(const std::string& name, size_t ops, size_t batch, Op op) {
+    Result r;
+    r.name = name;
+    r.ops = ops;
+    std::vector<double> samples;
+    samples.reserve(ops / batch + 1);
+
+    size_t allocsBefore = g_allocations.load();
+    auto begin = Clock::now();
+    for (size_t done = 0; done < ops;) {
+        size_t n = std::min(batch, ops - done);
+        auto t0 = Clock::now();
+        for (size_t i = 0; i < n; ++i) op(done + i);
+        auto t1 = Clock::now();
+        samples.push_back(std::chrono::duration<double, std::nano>(t1 - t0).count() / static_cast<double>(n));
+        done += n;
+    }
+    r.seconds = std::chrono::duration<double>(Clock::now() - begin).count();
+    // the samples vector was reserved up front, so only op's own allocations are counted
+    r.allocsPerOp = static_cast<double>(g_allocations.load() - allocsBefore) / static_cast<double>(ops);
+
+    std::sort(samples.begin(), samples.end());
+    auto pct = [&](double p) { return samples[std::min(samples.size() - 1, static_cast<size_t>(p * static_cast<double>(samples.size())))]; };
+    r.p50 = pct(0.50);
+    r.p90 = pct(0.90);
+    r.p99 = pct(0.99);
+    r.max = samples.back();
+    return r;
+}
+
+static void report(const Options& opt, size_t docBytes, size_t scalars, const std::vector<Result>& results) {
+    if (opt.format == "json") {
+        std::printf("{\n  \"config\": {\"depth\": %d, \"width\": %d, \"list\": %d, \"comments\": %.3f, \"types\": \"%s\", "
+                    "\"seed\": %u, \"bytes\": %zu, \"scalars\": %zu},\n  \"results\": [\n",
+                    opt.depth, opt.width, opt.listLength, opt.comments, opt.types.c_str(), opt.seed, docBytes, scalars);
+        for (size_t i = 0; i < results.size(); ++i) {
+            const Result& r = results[i];
+            std::printf("    {\"name\": \"%s\", \"ops\": %zu, \"ops_per_sec\": %.1f, \"bytes_per_sec\": %.1f, "
+                        "\"p50_ns\": %.1f, \"p90_ns\": %.1f, \"p99_ns\": %.1f, \"max_ns\": %.1f, \"allocs_per_op\": %.3f}%s\n",
+                        r.name.c_str(), r.ops, static_cast<double>(r.ops) / r.seconds, r.bytesPerSecond,
+                        r.p50, r.p90, r.p99, r.max, r.allocsPerOp, i + 1 < results.size() ? "," : "");
+        }
+        std::printf("  ]\n}\n");
+    } else if (opt.format == "csv") {
+        std::printf("name,ops,ops_per_sec,bytes_per_sec,p50_ns,p90_ns,p99_ns,max_ns,allocs_per_op\n");
+        for (const auto& r : results) {
+            std::printf("%s,%zu,%.1f,%.1f,%.1f,%.1f,%.1f,%.1f,%.3f\n", r.name.c_str(), r.ops,
+                        static_cast<double>(r.ops) / r.seconds, r.bytesPerSecond, r.p50, r.p90, r.p99, r.max, r.allocsPerOp);
+        }
+    } else {
+        std::printf("document: %.2f KiB, %zu scalars (depth %d, width %d, list %d, comments %.2f, types %s)\n\n",
+                    static_cast<double>(docBytes) / 1024.0, scalars, opt.depth, opt.width, opt.listLength, opt.comments, opt.types.c_str());
+        std::printf("%-26s %12s %10s %10s %10s %10s %10s %10s\n", "benchmark", "ops/s", "MiB/s", "p50 ns", "p90 ns", "p99 ns", "max ns", "allocs/op");
+        for (const auto& r : results) {
+            std::printf("%-26s %12.0f %10.2f %10.1f %10.1f %10.1f %10.1f %10.2f\n", r.name.c_str(),
+                        static_cast<double>(r.ops) / r.seconds, r.bytesPerSecond / (1024.0 * 1024.0),
+                        r.p50, r.p90, r.p99, r.max, r.allocsPerOp);
+        }
+    }
+}
+
+static bool parseArgs(int argc, char* argv[], Options& opt) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (i + 1 >= argc) return false;
+        std::string val = argv[++i];
+        if (arg == "--depth") opt.depth = std::max(1, std::atoi(val.c_str()));
+        else if (arg == "--width") opt.width = std::max(1, std::atoi(val.c_str()));
+        else if (arg == "--list") opt.listLength = std::max(1, std::atoi(val.c_str()));
+        else if (arg == "--comments") opt.comments = std::atof(val.c_str());
+        else if (arg == "--types") opt.types = val.empty() ? "s" : val;
+        else if (arg == "--iterations") opt.iterations = std::max<size_t>(1, std::strtoull(val.c_str(), nullptr, 10));
+        else if (arg == "--seed") opt.seed = static_cast<unsigned>(std::strtoul(val.c_str(), nullptr, 10));
+        else if (arg == "--format") opt.format = val;
+        else if (arg == "--keep") opt.keep = val;
+        else return false;
+    }
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    Options opt;
+    if (!parseArgs(argc, argv, opt)) {
+        std::fprintf(stderr, "usage: %s [--depth N] [--width N] [--list N] [--comments 0..1] [--types sidbl] "
+                             "[--iterations N] [--seed N] [--format text|json|csv] [--keep file.hc]\n", argv[0]);
+        return 2;
+    }
+
+    Generator gen(opt);
+    std::string text = gen.Generate();
+    if (gen.Scalars.empty()) {
+        std::fprintf(stderr, "generated document has no scalar keys, widen --types\n");
+        return 2;
+    }
+
+    namespace fs = std::filesystem;
+    std::string file = opt.keep.empty() ? (fs::temp_directory_path() / "hc_suite_input.hc").string() : opt.keep;
+    {
+        std::ofstream out(file, std::ios::binary);
+        out << text;
+    }
+    std::string outFile = (fs::temp_directory_path() / "hc_suite_output.hc").string();
+
+    std::vector<Result> results;
+    const size_t docRounds = std::max<size_t>(5, opt.iterations / std::max<size_t>(1, gen.Scalars.size()));
+    const auto docBytes = static_cast<double>(text.size());
+
+    HotConfig cfg;
+    Result load = measure("loadFromFile", docRounds, 1, [&](size_t) { cfg.loadFromFile(file); });
+    load.bytesPerSecond = docBytes * static_cast<double>(load.ops) / load.seconds;
+    results.push_back(load);
+
+    const auto& paths = gen.Scalars;
+    size_t sink = 0;
+    results.push_back(measure("get", opt.iterations, 64, [&](size_t i) {
+        sink += cfg.get(paths[i % paths.size()]) != nullptr;
+    }));
+    results.push_back(measure("set (existing)", opt.iterations, 64, [&](size_t i) {
+        cfg.set(paths[i % paths.size()], HCValue(static_cast<int>(i)));
+    }));
+
+    std::ostringstream sink_os;
+    Result write = measure("writeMap", docRounds, 1, [&](size_t) {
+        sink_os.str({});
+        cfg.writeMap(sink_os, cfg.root);
+    });
+    write.bytesPerSecond = static_cast<double>(sink_os.str().size()) * static_cast<double>(write.ops) / write.seconds;
+    results.push_back(write);
+
+    Result save = measure("save", docRounds, 1, [&](size_t) { cfg.save(outFile); });
+    save.bytesPerSecond = static_cast<double>(sink_os.str().size()) * static_cast<double>(save.ops) / save.seconds;
+    results.push_back(save);
+
+    // typed getters on a fresh load, so values still hold the generated text
+    ConfigManager manager;
+    manager.Load(file);
+    std::vector<std::string> ints, doubles, bools, strings;
+    for (size_t i = 0; i < paths.size(); ++i) {
+        switch (gen.Kinds[i]) {
+            case 'i': ints.push_back(paths[i]); break;
+            case 'd': doubles.push_back(paths[i]); break;
+            case 'b': bools.push_back(paths[i]); break;
+            default:  strings.push_back(paths[i]); break;
+        }
+    }
+    if (!ints.empty()) results.push_back(measure("ConfigManager::GetInt", opt.iterations, 64, [&](size_t i) {
+        sink += static_cast<size_t>(manager.GetInt(ints[i % ints.size()]));
+    }));
+    if (!doubles.empty()) results.push_back(measure("ConfigManager::GetDouble", opt.iterations, 64, [&](size_t i) {
+        sink += static_cast<size_t>(manager.GetDouble(doubles[i % doubles.size()]));
+    }));
+    if (!bools.empty()) results.push_back(measure("ConfigManager::GetBool", opt.iterations, 64, [&](size_t i) {
+        sink += manager.GetBool(bools[i % bools.size()]);
+    }));
+    if (!strings.empty()) results.push_back(measure("ConfigManager::GetString", opt.iterations, 64, [&](size_t i) {
+        sink += manager.GetString(strings[i % strings.size()]).size();
+    }));
+
+    report(opt, text.size(), paths.size(), results);
+    if (opt.keep.empty()) fs::remove(file);
+    fs::remove(outFile);
+    return sink == 0xFFFFFFFF ? 1 : 0;
+}
@@ -0,0 +1,86 @@
+// HotConfig version history benchmark
+// keeping a version of a config by deep-copying HotConfig::root, vs committing it to an
+// HCVersions history (unchanged subtrees shared with the previous version), vs deriving the new
+// version directly with HCTree::set. every round changes one value first.
+//
+// g++ -std=c++17 -O2 -pthread -I../include HotConfigVersions.cpp -o hc_versions
+// ./hc_versions [sections] [rounds]
+
+#include "../include/Internal/Configuration/Persistent.hpp"
+#include "../include/Internal/Time&Date/Misc.hpp"
+#include "AllocCounter.hpp"
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+using namespace MF::Configurations::Internal::Parser;
+
+static std::string generate(size_t sections) {
+    std::string out;
+    for (size_t s = 0; s < sections; ++s) {
+        out += "Tenant" + std::to_string(s) + ":\n";
+        out += "    Build:\n";
+        out += "        Version: \"1." + std::to_string(s % 17) + ".0\"\n";
+        out += "        Channel: Production # release channel\n";
+        out += "    Limits:\n";
+        out += "        Requests: " + std::to_string(s * 13) + "\n";
+        out += "        Ratio: 0." + std::to_string(s % 100 + 1) + "\n";
+        out += "    Hosts:\n";
+        for (int i = 0; i < 4; ++i) out += "        - host" + std::to_string(i) + ".tenant" + std::to_string(s) + ".local\n";
+    }
+    return out;
+}
+
+template <typename Fn>
+static void run(const char* name, int rounds, Fn fn) {
+    size_t allocs = g_allocations.load();
+    Time::Timer timer(Time::Timer::Precision::Milliseconds);
+    timer.start();
+    for (int r = 0; r < rounds; ++r) fn(r);
+    timer.stop();
+    double us = timer.elapsed(Time::Timer::Precision::Seconds) * 1e6 / rounds;
+    std::printf("%-22s %12.2f us %14.1f allocs/version\n", name, us,
+                static_cast<double>(g_allocations.load() - allocs) / rounds);
+}
+
+int main(int argc, char* argv[]) {
+    size_t sections = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 2000;
+    int rounds = argc > 2 ? std::atoi(argv[2]) : 200;
+
+    HotConfig cfg;
+    if (!cfg.parseBuffer(generate(sections))) {
+        std::printf("generated document doesn't parse\n");
+        return 1;
+    }
+    std::printf("%zu sections, %d versions each\n", sections, rounds);
+    auto path = [&](int r) { return "Tenant" + std::to_string((r * 7919) % sections) + ".Limits.Requests"; };
+
+    std::vector<HCMap> copies;
+    copies.reserve(static_cast<size_t>(rounds));
+    run("deep copy", rounds, [&](int r) {
+        cfg.set(path(r), HCValue(r + 1));
+        copies.push_back(cfg.root);
+    });
+    copies.clear();
+
+    HCVersions history(static_cast<size_t>(rounds));
+    history.Commit(cfg.root);
+    run("HCVersions::Commit", rounds, [&](int r) {
+        cfg.set(path(r), HCValue(r + 2));
+        history.Commit(cfg.root);
+    });
+
+    HCTree tree = history.Current();
+    std::vector<HCTree> versions;
+    versions.reserve(static_cast<size_t>(rounds));
+    run("HCTree::set", rounds, [&](int r) {
+        tree = tree.set(path(r), HCValue(r + 2));
+        versions.push_back(tree);
+    });
+
+    // the same values were set on both sides
+    bool same = tree.hash() == hashMap(cfg.root);
+    std::printf("history and tree agree: %s\n", same ? "yes" : "NO");
+    return same ? 0 : 1;
+}
@@ -0,0 +1,82 @@
+// MF_PROFILE_SCOPE benchmark
+// cost of one zone around an empty body: with profiling enabled (recorded), compiled in but not
+// enabled, and a manual Time::Timer start/stop/elapsedString as InitializeMFWork used to do it.
+// then records nested zones on several threads and writes them as a Chrome trace.
+// build with -DMF_DISABLE_PROFILING to check that the macros compile out.
+//
+// g++ -std=c++17 -O2 -pthread -I../include ProfilerZones.cpp -o profiler_zones
+// ./profiler_zones [zones] [threads]
+
+#include "../include/Internal/Profiling/Profiler.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <thread>
+#include <vector>
+
+static volatile int sink = 0;
+
+static void leaf() {
+    MF_PROFILE_SCOPE("leaf");
+    sink = sink + 1;
+}
+
+static void branch() {
+    MF_PROFILE_SCOPE("branch");
+    for (int i = 0; i < 4; ++i) leaf();
+}
+
+template <typename Fn>
+static double perCall(size_t n, Fn fn) {
+    Time::CycleTimer timer;
+    timer.start();
+    for (size_t i = 0; i < n; ++i) fn();
+    timer.stop();
+    return static_cast<double>(timer.elapsedNs().count()) / static_cast<double>(n);
+}
+
+int main(int argc, char* argv[]) {
+    size_t zones = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 2000000;
+    int threads = argc > 2 ? std::atoi(argv[2]) : 4;
+    Time::CycleTimer::Calibrate();
+
+    double disabled = perCall(zones, [] { MF_PROFILE_SCOPE("zone"); sink = sink + 1; });
+    MF::Profiling::Enable();
+    double enabled = perCall(zones, [] { MF_PROFILE_SCOPE("zone"); sink = sink + 1; });
+    size_t manualRounds = zones / 10;
+    double manual = perCall(manualRounds, [] {
+        Time::Timer timer("ms");
+        timer.start();
+        sink = sink + 1;
+        timer.stop();
+        if (timer.elapsedString().empty()) sink = 0;
+    });
+    std::printf("%zu zones, counter %s\n", zones, Time::cycles::source().name);
+    std::printf("%-32s %8.1f ns\n", "zone, profiling not enabled", disabled);
+    std::printf("%-32s %8.1f ns\n", "zone, recorded", enabled);
+    std::printf("%-32s %8.1f ns\n", "Timer + elapsedString", manual);
+
+    MF::Profiling::Clear();
+    std::vector<std::thread> workers;
+    Time::Timer timer(Time::Timer::Precision::Milliseconds);
+    timer.start();
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&] {
+            for (size_t i = 0; i < zones / 5 / static_cast<size_t>(threads); ++i) branch();
+        });
+    }
+    for (auto& w : workers) w.join();
+    timer.stop();
+    auto traces = MF::Profiling::Collect();
+    size_t events = 0;
+    for (const auto& t : traces) events += t.events.size();
+    std::printf("%d threads recorded %zu zones in %.1f ms\n", threads, events, timer.elapsed());
+
+    MF::Profiling::PrintSummary(MF::Print::LogLevel::Error);
+    std::string path = (std::filesystem::temp_directory_path() / "mf_profile.json").string();
+    timer.start();
+    bool written = MF::Profiling::ExportChromeTrace(path);
+    timer.stop();
+    std::printf("trace %s: %s (%.1f ms)\n", written ? "written" : "FAILED", path.c_str(), timer.elapsed());
+    return 0;
+}
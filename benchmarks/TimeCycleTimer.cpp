@@ -0,0 +1,67 @@
+// Time::CycleTimer benchmark
+// cost of one start/stop pair for Time::Timer (steady_clock) and Time::CycleTimer (cycle counter),
+// the smallest section each can resolve, and how far the calibrated counter drifts from
+// steady_clock over a longer interval.
+//
+// g++ -std=c++17 -O2 -I../include TimeCycleTimer.cpp -o time_cycle_timer
+// ./time_cycle_timer [rounds]
+
+#include "../include/Internal/Time&Date/CycleTimer.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+
+template <typename T>
+static double pairCost(int rounds) {
+    T timer(T::Precision::Nanoseconds);
+    Time::Timer outer(Time::Timer::Precision::Nanoseconds);
+    double sink = 0.0;
+    outer.start();
+    for (int r = 0; r < rounds; ++r) {
+        timer.start();
+        timer.stop();
+        sink += timer.elapsed();
+    }
+    outer.stop();
+    return outer.elapsed() / rounds + (sink < 0 ? 1 : 0);
+}
+
+// smallest non-zero reading over back-to-back start/stop pairs
+template <typename T>
+static double resolution(int rounds) {
+    T timer(T::Precision::Nanoseconds);
+    double best = 1e300;
+    for (int r = 0; r < rounds; ++r) {
+        timer.start();
+        timer.stop();
+        double ns = timer.elapsed();
+        if (ns > 0.0 && ns < best) best = ns;
+    }
+    return best;
+}
+
+int main(int argc, char* argv[]) {
+    int rounds = argc > 1 ? std::atoi(argv[1]) : 1000000;
+
+    Time::Timer calibration(Time::Timer::Precision::Milliseconds);
+    calibration.start();
+    const auto& source = Time::CycleTimer::Calibrate();
+    calibration.stop();
+    std::printf("counter: %s (invariant %s), %.4f ns/tick, calibrated in %s\n", source.name, source.invariant ? "yes" : "no",
+                source.nsPerTick, calibration.elapsedString().c_str());
+
+    std::printf("%-16s %10s %14s\n", "", "start+stop", "resolution");
+    std::printf("%-16s %8.1f ns %12.1f ns\n", "Time::Timer", pairCost<Time::Timer>(rounds), resolution<Time::Timer>(rounds));
+    std::printf("%-16s %8.1f ns %12.1f ns\n", "Time::CycleTimer", pairCost<Time::CycleTimer>(rounds), resolution<Time::CycleTimer>(rounds));
+
+    Time::Timer wall(Time::Timer::Precision::Nanoseconds);
+    Time::CycleTimer cycles;
+    wall.start();
+    cycles.start();
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    cycles.stop();
+    wall.stop();
+    std::printf("200 ms sleep: steady_clock %s, CycleTimer %s (%+.1f ppm)\n", wall.elapsedString().c_str(),
+                cycles.elapsedString().c_str(), (cycles.elapsed() - wall.elapsed()) / wall.elapsed() * 1e6);
+    return 0;
+}
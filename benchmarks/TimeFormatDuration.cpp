@@ -0,0 +1,125 @@
+// Time::formatDuration / Timer::elapsedString benchmark
+// the buffer formatters (formatDurationTo, formatDurationText, Timer::elapsedText) against the
+// string versions and the previous ostringstream implementation (kept below as
+// legacyFormatDuration). reports ns per call and heap allocations per call.
+//
+// g++ -std=c++17 -O2 -I../include TimeFormatDuration.cpp -o time_format_duration
+// ./time_format_duration [rounds]
+
+#include "../include/Internal/Time&Date/Misc.hpp"
+#include "AllocCounter.hpp"
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+namespace Time {
+
+// format duration (nanoseconds) into readable string
+// respects descending units; drops zero units unless showZeros==true
+static inline std::string legacyFormatDuration(ns_t ns, const FormatOptions& opts = {}) {
+    long long total_ns = ns.count();
+    if (total_ns < 0) total_ns = 0;
+
+    struct UnitOut { std::string name; long long qty; };
+
+    std::vector<UnitOut> parts;
+    long long rest_ns = total_ns;
+
+    for (const auto &p : unit_table_desc) {
+        const std::string &unit = p.first;
+        long double unit_ns_ld = p.second;
+        long long unit_ns = (long long)std::llround(unit_ns_ld);
+        if (unit_ns <= 0) continue;
+        long long qty = (long long)(rest_ns / unit_ns);
+        if (qty > 0) {
+            parts.push_back({unit, qty});
+            rest_ns -= qty * unit_ns;
+        } else {
+            if (opts.showZeros) parts.push_back({unit, 0});
+        }
+    }
+
+    // If nothing and showZeros false, return "0ms"
+    if (parts.empty()) {
+        if (opts.showZeros) {
+            std::ostringstream os; os << "0ms"; return os.str();
+        } else {
+            return std::string("0ms");
+        }
+    }
+
+    // build output respecting maxUnits
+    std::ostringstream os;
+    int shown = 0;
+    int maxu = opts.maxUnits <= 0 ? (int)parts.size() : std::min((int)parts.size(), opts.maxUnits);
+
+    for (size_t i = 0; i < parts.size() && shown < maxu; ++i) {
+        if (!opts.showZeros && parts[i].qty == 0) continue;
+        if (shown) os << " ";
+        os << parts[i].qty << parts[i].name;
+        ++shown;
+    }
+
+    // if we limited to 1 unit and there is remainder, show decimal fraction for that unit
+    if (opts.maxUnits == 1 && !parts.empty()) {
+        // compute largest unit (first non-zero)
+        const auto &p = parts.front();
+        long double unit_ns_ld = 0.0L;
+        for (auto &ut : unit_table_desc) if (ut.first == p.name) unit_ns_ld = ut.second;
+        if (unit_ns_ld > 0.0L) {
+            long double fullVal = (long double)total_ns / unit_ns_ld;
+            // show with 3 decimal places if fractional
+            std::ostringstream os2;
+            os2 << std::fixed << std::setprecision(3);
+            os2 << fullVal << p.name;
+            return os2.str();
+        }
+    }
+
+    return os.str();
+}
+
+}
+
+template <typename Fn>
+static void run(const char* name, const std::vector<Time::ns_t>& inputs, int rounds, Fn fn) {
+    size_t sink = 0;
+    size_t allocs = g_allocations.load();
+    Time::Timer timer(Time::Timer::Precision::Milliseconds);
+    timer.start();
+    for (int r = 0; r < rounds; ++r) {
+        for (auto ns : inputs) sink += fn(ns);
+    }
+    timer.stop();
+    double calls = static_cast<double>(rounds) * static_cast<double>(inputs.size());
+    std::printf("%-30s %8.1f ns/call %8.2f allocs/call (%zu)\n", name, timer.elapsed(Time::Timer::Precision::Seconds) * 1e9 / calls,
+                static_cast<double>(g_allocations.load() - allocs) / calls, sink % 7);
+}
+
+int main(int argc, char* argv[]) {
+    int rounds = argc > 1 ? std::atoi(argv[1]) : 100000;
+    std::vector<Time::ns_t> inputs;
+    for (long long ns : {341000LL, 12500000LL, 1500000000LL, 93000000000LL, 5400000000000LL, 200000000000000LL, 0LL, 987654321LL})
+        inputs.push_back(Time::ns_t(ns));
+    Time::FormatOptions one;
+    one.maxUnits = 1;
+
+    std::printf("%zu durations, %d rounds\n", inputs.size(), rounds);
+    run("legacy formatDuration", inputs, rounds / 10, [](Time::ns_t ns) { return Time::legacyFormatDuration(ns).size(); });
+    run("formatDuration (string)", inputs, rounds, [](Time::ns_t ns) { return Time::formatDuration(ns).size(); });
+    run("formatDurationText", inputs, rounds, [](Time::ns_t ns) { return Time::formatDurationText(ns).size; });
+    run("formatDurationTo", inputs, rounds, [](Time::ns_t ns) {
+        char buffer[64];
+        return static_cast<size_t>(Time::formatDurationTo(buffer, buffer + sizeof(buffer), ns).ptr - buffer);
+    });
+    run("legacy formatDuration, 1 unit", inputs, rounds / 10, [&](Time::ns_t ns) { return Time::legacyFormatDuration(ns, one).size(); });
+    run("formatDurationText, 1 unit", inputs, rounds, [&](Time::ns_t ns) { return Time::formatDurationText(ns, one).size; });
+
+    Time::Timer timer;
+    timer.start();
+    run("Timer::elapsedString", inputs, rounds, [&](Time::ns_t) { return timer.elapsedString().size(); });
+    run("Timer::elapsedText", inputs, rounds, [&](Time::ns_t) { return timer.elapsedText().size; });
+    return 0;
+}
@@ -0,0 +1,93 @@
+// Time::Histogram benchmark
+// cost of recording one latency: Time::Histogram (one thread), Time::ConcurrentHistogram (all
+// threads at once), and the usual fallback of pushing into a mutex-guarded vector and sorting it
+// for percentiles. then the cost of a snapshot plus p50/p90/p99/p999 queries, and the memory each
+// keeps.
+//
+// g++ -std=c++17 -O2 -pthread -I../include TimeHistogram.cpp -o time_histogram
+// ./time_histogram [records] [threads]
+
+#include "../include/Internal/Time&Date/Histogram.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+static std::vector<Time::ns_t> samples(size_t n) {
+    std::mt19937_64 rng(42);
+    std::lognormal_distribution<double> dist(10.0, 2.0);
+    std::vector<Time::ns_t> out(n);
+    for (auto& v : out) v = Time::ns_t(static_cast<long long>(std::min(dist(rng), 3.6e12)));
+    return out;
+}
+
+template <typename Fn>
+static double timedMs(Fn fn) {
+    Time::Timer timer(Time::Timer::Precision::Milliseconds);
+    timer.start();
+    fn();
+    timer.stop();
+    return timer.elapsed();
+}
+
+template <typename Fn>
+static double parallelNsPerRecord(int threads, size_t perThread, Fn fn) {
+    double ms = timedMs([&] {
+        std::vector<std::thread> workers;
+        for (int t = 0; t < threads; ++t) workers.emplace_back([&, t] { fn(t); });
+        for (auto& w : workers) w.join();
+    });
+    return ms * 1e6 / static_cast<double>(perThread * threads);
+}
+
+int main(int argc, char* argv[]) {
+    size_t records = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 4000000;
+    int threads = argc > 2 ? std::atoi(argv[2]) : 4;
+    auto values = samples(records);
+    size_t perThread = records / static_cast<size_t>(threads);
+    std::printf("%zu records, %d threads\n", records, threads);
+
+    Time::Histogram single;
+    double singleMs = timedMs([&] { for (auto v : values) single.record(v); });
+    std::printf("%-30s %8.2f ns/record\n", "Histogram", singleMs * 1e6 / static_cast<double>(records));
+
+    Time::ConcurrentHistogram shared;
+    double concurrentNs = parallelNsPerRecord(threads, perThread, [&](int t) {
+        for (size_t i = 0; i < perThread; ++i) shared.record(values[t * perThread + i]);
+    });
+    std::printf("%-30s %8.2f ns/record\n", "ConcurrentHistogram", concurrentNs);
+
+    std::mutex mutex;
+    std::vector<Time::ns_t> collected;
+    double vectorNs = parallelNsPerRecord(threads, perThread, [&](int t) {
+        for (size_t i = 0; i < perThread; ++i) {
+            std::lock_guard<std::mutex> lock(mutex);
+            collected.push_back(values[t * perThread + i]);
+        }
+    });
+    std::printf("%-30s %8.2f ns/record\n", "mutex + vector", vectorNs);
+
+    Time::Histogram snapshot = shared.snapshot();
+    long long sink = 0;
+    double queryMs = timedMs([&] {
+        for (int i = 0; i < 100; ++i) {
+            shared.snapshotInto(snapshot);
+            sink += snapshot.p50().count() + snapshot.p90().count() + snapshot.p99().count() + snapshot.p999().count();
+        }
+    });
+    double sortMs = timedMs([&] {
+        std::sort(collected.begin(), collected.end());
+        for (double p : {0.5, 0.9, 0.99, 0.999}) sink += collected[static_cast<size_t>(p * static_cast<double>(collected.size() - 1))].count();
+    });
+    std::printf("%-30s %8.3f ms\n", "snapshot + 4 percentiles", queryMs / 100);
+    std::printf("%-30s %8.3f ms\n", "sort + 4 percentiles", sortMs);
+
+    size_t histogramBytes = snapshot.layout().countsLength * sizeof(std::uint64_t);
+    std::printf("memory: Histogram %zu KiB, ConcurrentHistogram %zu KiB, vector %zu KiB\n", histogramBytes / 1024,
+                histogramBytes * std::clamp(std::thread::hardware_concurrency(), 1u, 64u) / 1024,
+                collected.size() * sizeof(Time::ns_t) / 1024);
+    std::printf("%s (%lld)\n", snapshot.summary().c_str(), sink % 10);
+    return 0;
+}
@@ -1,18 +1,25 @@
 #pragma once
 
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <optional>
 #include <string>
+#include <utility>
 #include <variant>
+#include <vector>
 #include "Parser.hpp"
+#include "Include.hpp"
+#include "Diff.hpp"
+#include "Json.hpp"
+#include "Overlay.hpp"
+#include "Lazy.hpp"
+#include "Persistent.hpp"
+#include "Shared.hpp"
+#include "Query.hpp"
 
-using ValType = std::variant<
-    std::monostate,
-    bool,
-    int,
-    double,
-    std::string,
-    MF::Configurations::Internal::Parser::HCMap,
-    MF::Configurations::Internal::Parser::HCList
->;
+using ValType = MF::Configurations::Internal::Parser::HCValue::TypedValue;
 
 namespace MF::Configurations {
     class ConfigManager {
@@ -20,61 +27,265 @@ namespace MF::Configurations {
         MF::Configurations::Internal::Parser::HotConfig Configuration;
         std::string Filename;
         bool Loaded = false;
+        // set by LoadWithIncludes, fragments are shared through SharedFragmentCache()
+        std::optional<Internal::Parser::HCIncludes> Includes;
+        // environment/argument layers set by ApplyOverrides, in precedence order
+        std::vector<Internal::Parser::HCOverride> Overrides;
+        // file + overrides, flattened. only built once overrides are applied
+        Internal::Parser::HCResolvedView Resolved;
+        // set by LoadLazy until something needs the whole tree
+        std::unique_ptr<Internal::Parser::HCLazyDocument> Lazy;
+        // versions recorded by Commit, shared structurally (see Persistent.hpp)
+        Internal::Parser::HCVersions History;
+
+        ConfigManager() = default;
+        // a lazy copy reopens the same text; the resolved view is rebuilt over the copy's tree
+        ConfigManager(const ConfigManager& other)
+            : Configuration(other.Configuration), Filename(other.Filename), Loaded(other.Loaded), Includes(other.Includes),
+              Overrides(other.Overrides), History(other.History) {
+            if (other.Lazy) {
+                Lazy = std::make_unique<Internal::Parser::HCLazyDocument>();
+                Lazy->Open(other.Lazy->Text());
+            }
+            if (other.Resolved.Built()) Resolved.Build(Configuration.root, Overrides);
+        }
+        ConfigManager& operator=(const ConfigManager& other) {
+            if (this != &other) *this = ConfigManager(other);
+            return *this;
+        }
+        ConfigManager(ConfigManager&&) = default;
+        ConfigManager& operator=(ConfigManager&&) = default;
+
+        // merges MF_CFG__A__B environment variables and then --cfg.A.B= arguments over the file
+        // (see Overlay.hpp). reads go through the resolved view from then on; Save still writes
+        // the file layer only.
+        void ApplyOverrides(const Runtime::Arguments::Parser* arguments = nullptr, bool environment = true) {
+            materialize();
+            Overrides.clear();
+            if (environment) Overrides = Internal::Parser::CollectEnvironmentOverrides();
+            if (arguments) {
+                auto fromArguments = Internal::Parser::CollectArgumentOverrides(*arguments);
+                Overrides.insert(Overrides.end(), std::make_move_iterator(fromArguments.begin()), std::make_move_iterator(fromArguments.end()));
+            }
+            Resolved.Build(Configuration.root, Overrides);
+        }
+
+        // where a key's value comes from, nullopt if it doesn't exist
+        std::optional<Internal::Parser::HCLayer> SourceOf(const std::string& keyPath) {
+            if (Resolved.Built()) {
+                auto entry = Resolved.Find(keyPath);
+                if (!entry) return std::nullopt;
+                return entry->layer;
+            }
+            if (!Configuration.get(keyPath)) return std::nullopt;
+            return Internal::Parser::HCLayer::File;
+        }
 
         bool Has(const std::string& keyPath) {
-            auto val = Configuration.get(keyPath);
-            return val != nullptr;
+            return find(keyPath) != nullptr;
         }
 
         bool Load(const std::string& filename, bool setFileName = true) {
+            Includes.reset();
+            Lazy.reset();
             Loaded = Configuration.loadFromFile(filename, setFileName);
+            refreshResolved();
             if (Loaded && setFileName) Filename = filename;
             return Loaded;
         }
 
+        // like Load, but top-level sections are only parsed when a lookup first reaches them
+        // (see Lazy.hpp). Set, Save, Query and the other whole-tree operations parse the rest first.
+        // falls back to Load for files that can't be split into sections.
+        bool LoadLazy(const std::string& filename) {
+            auto lazy = std::make_unique<Internal::Parser::HCLazyDocument>();
+            if (!FilesManager::IsFile(filename)) return Loaded = false;
+            if (!lazy->OpenFile(filename)) return Load(filename);
+            Includes.reset();
+            Lazy = std::move(lazy);
+            Configuration.root.clear();
+            Configuration.filename = filename;
+            Filename = filename;
+            Loaded = true;
+            // the resolved view is built from the tree, so with overrides applied nothing stays lazy
+            if (Resolved.Built()) materialize();
+            refreshResolved();
+            return true;
+        }
+
+        // like Load, but `include:` directives are resolved (see Include.hpp)
+        bool LoadWithIncludes(const std::string& filename) {
+            Internal::Parser::HCIncludes includes;
+            Loaded = includes.Load(Configuration, filename);
+            if (!Loaded) return false;
+            Lazy.reset();
+            Includes = std::move(includes);
+            Filename = filename;
+            refreshResolved();
+            return true;
+        }
+
+        // re-reads the config from disk. `changed` tells if anything did, `changes` lists the key paths
+        // that were added, removed or modified (see Diff.hpp). if the file no longer loads, the
+        // previous tree is kept and false is returned.
+        bool Reload(bool* changed = nullptr, std::vector<Internal::Parser::HCChange>* changes = nullptr) {
+            if (changes) changes->clear();
+            if (Includes && !Includes->Stale()) {
+                if (changed) *changed = false;
+                return true;
+            }
+
+            if (Lazy && !changes) {
+                // stay lazy, the text tells whether anything changed
+                auto lazy = std::make_unique<Internal::Parser::HCLazyDocument>();
+                if (!lazy->OpenFile(Filename)) return false;
+                if (changed) *changed = lazy->Text() != Lazy->Text();
+                Lazy = std::move(lazy);
+                return true;
+            }
+            materialize();
+
+            Internal::Parser::HCMap before = std::move(Configuration.root);
+            bool ok = Includes ? Includes->Load(Configuration, Includes->MainFile) : Configuration.loadFromFile(Filename);
+            if (!ok) {
+                Configuration.root = std::move(before);
+                return false;
+            }
+            Loaded = true;
+            refreshResolved();
+            if (changes) *changes = Internal::Parser::diffTrees(before, Configuration.root);
+            if (changed) *changed = changes ? !changes->empty() : Internal::Parser::hashMap(before) != Internal::Parser::hashMap(Configuration.root);
+            return true;
+        }
+
+        // records the current tree as a new version in History and returns its number. only what
+        // changed since the last commit is copied; readers can keep any version they took
+        std::uint64_t Commit() {
+            materialize();
+            return History.Commit(Configuration.root);
+        }
+
+        // replaces the tree with a committed version (not written to disk, Save does that)
+        bool Rollback(std::uint64_t version) {
+            auto tree = History.At(version);
+            if (!tree) return false;
+            Lazy.reset();
+            Configuration.root = tree->toMap();
+            refreshResolved();
+            return true;
+        }
+
+        // the tree as a flat snapshot (see Shared.hpp), for HCSharedPublisher or a file
+        std::string Snapshot(std::uint64_t version = 0) {
+            materialize();
+            return Internal::Parser::HCSnapshotWriter::Write(Configuration.root, version);
+        }
+
+        // replaces the tree with a copy of a snapshot, for code that needs the whole API.
+        // reading the snapshot through HCSnapshotView directly needs no copy
+        bool LoadSnapshot(const Internal::Parser::HCSnapshotView& snapshot) {
+            if (!snapshot.Valid()) return Loaded = false;
+            Includes.reset();
+            Lazy.reset();
+            Configuration.root = snapshot.ToMap();
+            Loaded = true;
+            refreshResolved();
+            return true;
+        }
+
+        // every value matching a query such as "Tenants.*.Build.Version" (see Query.hpp), empty if none
+        // or if the expression is malformed. compile the query once with HCQuery::Compile when it's run often.
+        std::vector<const Internal::Parser::HCValue*> Query(const std::string& expr) {
+            auto query = Internal::Parser::HCQuery::Compile(expr);
+            if (!query) return {};
+            materialize();
+            return query->Run(std::as_const(Configuration.root));
+        }
+
+        std::vector<const Internal::Parser::HCValue*> Query(const Internal::Parser::HCQuery& query) {
+            materialize();
+            return query.Run(std::as_const(Configuration.root));
+        }
+
         bool Get(const std::string& keyPath, ValType& OutValue) {
-            if (auto val = Configuration.get(keyPath)) {
-                OutValue = val->value;
+            if (auto val = find(keyPath)) {
+                OutValue = val->typed();
                 return true;
             }
             return false;
         }
 
+        // with reloadFile the value is saved to Filename and the file loaded again. a config loaded
+        // with includes can't be saved (see Save), so such a Set fails before changing anything;
+        // pass reloadFile = false to change it in memory only
         bool Set(const std::string& keyPath, const std::string& value, bool reloadFile = true) {
+            if (reloadFile && writesIncludedFile(Filename)) return false;
+            materialize();
             bool ok = Configuration.set(keyPath, Internal::Parser::HCValue(value));
             if (!ok) return false;
+            refreshResolved();
             if (reloadFile) return Save(Filename, true);
             return true;
         }
 
         bool Set(const std::string& keyPath, bool value, bool reloadFile = true) {
+            if (reloadFile && writesIncludedFile(Filename)) return false;
+            materialize();
             bool ok = Configuration.set(keyPath, Internal::Parser::HCValue(value));
             if (!ok) return false;
+            refreshResolved();
             if (reloadFile) return Save(Filename, true);
             return true;
         }
 
         bool Set(const std::string& keyPath, int value, bool reloadFile = true) {
+            if (reloadFile && writesIncludedFile(Filename)) return false;
+            materialize();
             bool ok = Configuration.set(keyPath, Internal::Parser::HCValue(value));
             if (!ok) return false;
+            refreshResolved();
             if (reloadFile) return Save(Filename, true);
             return true;
         }
 
         bool Set(const std::string& keyPath, double value, bool reloadFile = true) {
+            if (reloadFile && writesIncludedFile(Filename)) return false;
+            materialize();
             bool ok = Configuration.set(keyPath, Internal::Parser::HCValue(value));
             if (!ok) return false;
+            refreshResolved();
             if (reloadFile) return Save(Filename, true);
             return true;
         }
 
         bool Save(const std::string& filename = "", bool reloadAfter = false) {
             std::string fileToUse = filename.empty() ? Filename : filename;
+            if (writesIncludedFile(fileToUse)) return false;
+            materialize();
             if (!Configuration.save(fileToUse)) return false;
             if (reloadAfter) return Load(fileToUse);
             return true;
         }
 
+        // JSON export/import (see Json.hpp), comments are not kept
+        bool SaveJson(const std::string& filename, int indent = 2) {
+            materialize();
+            std::string out;
+            Internal::Parser::toJson(Configuration.root, out, indent);
+            out += '\n';
+            return !FilesManager::WriteStringToFile(filename, out).has_value();
+        }
+
+        bool LoadJson(const std::string& filename) {
+            auto content = FilesManager::ReadFileToString(filename);
+            if (!content) return false;
+            Includes.reset();
+            Lazy.reset();
+            Loaded = Internal::Parser::fromJson(*content, Configuration.root);
+            refreshResolved();
+            return Loaded;
+        }
+
         // legacy wrappers
         bool has(const std::string& keyPath) { return Has(keyPath); }
         bool get(const std::string& keyPath, ValType& OutValue) { return Get(keyPath, OutValue); }
@@ -87,16 +298,7 @@ namespace MF::Configurations {
 
         // typed getters
         bool TryGetBool(const std::string& keyPath, bool& out) {
-            if (auto val = Configuration.get(keyPath)) {
-                if (auto p = std::get_if<bool>(&val->value)) {
-                    out = *p;
-                    return true;
-                } else if (auto s = std::get_if<std::string>(&val->value)) {
-                    std::string v = Internal::Parser::trim(*s);
-                    if (Internal::Parser::iequals(v, "true")) { out = true; return true; }
-                    if (Internal::Parser::iequals(v, "false")) { out = false; return true; }
-                }
-            }
+            if (auto val = find(keyPath)) return val->tryBool(out);
             return false;
         }
 
@@ -107,20 +309,11 @@ namespace MF::Configurations {
         }
 
         bool TryGetInt(const std::string& keyPath, int& out) {
-            if (auto val = Configuration.get(keyPath)) {
-                if (auto p = std::get_if<int>(&val->value)) {
-                    out = *p;
-                    return true;
-                } else if (auto s = std::get_if<std::string>(&val->value)) {
-                    std::string v = Internal::Parser::trim(*s);
-                    try {
-                        size_t pos;
-                        out = std::stoi(v, &pos);
-                        if (pos == v.size()) return true;
-                    } catch (...) {}
-                }
-            }
-            return false;
+            std::int64_t wide;
+            if (!TryGetInt64(keyPath, wide)) return false;
+            if (wide < std::numeric_limits<int>::min() || wide > std::numeric_limits<int>::max()) return false;
+            out = static_cast<int>(wide);
+            return true;
         }
 
         int GetInt(const std::string& keyPath, int defaultVal = 0) {
@@ -129,20 +322,19 @@ namespace MF::Configurations {
             return out;
         }
 
+        bool TryGetInt64(const std::string& keyPath, std::int64_t& out) {
+            if (auto val = find(keyPath)) return val->tryInt64(out);
+            return false;
+        }
+
+        std::int64_t GetInt64(const std::string& keyPath, std::int64_t defaultVal = 0) {
+            std::int64_t out = defaultVal;
+            TryGetInt64(keyPath, out);
+            return out;
+        }
+
         bool TryGetDouble(const std::string& keyPath, double& out) {
-            if (auto val = Configuration.get(keyPath)) {
-                if (auto p = std::get_if<double>(&val->value)) {
-                    out = *p;
-                    return true;
-                } else if (auto s = std::get_if<std::string>(&val->value)) {
-                    std::string v = Internal::Parser::trim(*s);
-                    try {
-                        size_t pos;
-                        out = std::stod(v, &pos);
-                        if (pos == v.size()) return true;
-                    } catch (...) {}
-                }
-            }
+            if (auto val = find(keyPath)) return val->tryDouble(out);
             return false;
         }
 
@@ -152,8 +344,32 @@ namespace MF::Configurations {
             return out;
         }
 
+        // "1h 30m", "250ms", ... (Time::parseDuration syntax), parsed once per value
+        bool TryGetDuration(const std::string& keyPath, std::chrono::nanoseconds& out) {
+            if (auto val = find(keyPath)) return val->tryDuration(out);
+            return false;
+        }
+
+        std::chrono::nanoseconds GetDuration(const std::string& keyPath, std::chrono::nanoseconds defaultVal = {}) {
+            std::chrono::nanoseconds out = defaultVal;
+            TryGetDuration(keyPath, out);
+            return out;
+        }
+
+        // "64MiB", "1.5 GB", or a plain byte count
+        bool TryGetBytes(const std::string& keyPath, std::uint64_t& out) {
+            if (auto val = find(keyPath)) return val->tryBytes(out);
+            return false;
+        }
+
+        std::uint64_t GetBytes(const std::string& keyPath, std::uint64_t defaultVal = 0) {
+            std::uint64_t out = defaultVal;
+            TryGetBytes(keyPath, out);
+            return out;
+        }
+
         bool TryGetString(const std::string& keyPath, std::string& out) {
-            if (auto val = Configuration.get(keyPath)) {
+            if (auto val = find(keyPath)) {
                 out = val->asString();
                 return true;
             }
@@ -167,7 +383,7 @@ namespace MF::Configurations {
         }
 
         bool TryGetList(const std::string& keyPath, const Internal::Parser::HCList*& out) {
-            if (auto val = Configuration.get(keyPath)) {
+            if (auto val = find(keyPath)) {
                 if (val->isList()) {
                     out = &val->asList();
                     return true;
@@ -176,8 +392,29 @@ namespace MF::Configurations {
             return false;
         }
 
+        // contiguous views of lists stored compactly (see HCArray): all integers, all doubles or
+        // all strings, without comments. false for anything else, TryGetList works for every list.
+        // the view stays valid until the value is replaced (Set, Reload, ...)
+        bool TryGetInts(const std::string& keyPath, Internal::Parser::HCArrayView<std::int64_t>& out) {
+            auto arr = findArray(keyPath, Internal::Parser::HCArray::Kind::Int);
+            if (arr) out = arr->ints;
+            return arr != nullptr;
+        }
+
+        bool TryGetDoubles(const std::string& keyPath, Internal::Parser::HCArrayView<double>& out) {
+            auto arr = findArray(keyPath, Internal::Parser::HCArray::Kind::Double);
+            if (arr) out = arr->doubles;
+            return arr != nullptr;
+        }
+
+        bool TryGetStrings(const std::string& keyPath, Internal::Parser::HCArrayView<std::string>& out) {
+            auto arr = findArray(keyPath, Internal::Parser::HCArray::Kind::String);
+            if (arr) out = arr->strings;
+            return arr != nullptr;
+        }
+
         bool TryGetMap(const std::string& keyPath, const Internal::Parser::HCMap*& out) {
-            if (auto val = Configuration.get(keyPath)) {
+            if (auto val = find(keyPath)) {
                 if (val->isMap()) {
                     out = &val->asMap();
                     return true;
@@ -185,5 +422,48 @@ namespace MF::Configurations {
             }
             return false;
         }
+
+    private:
+        // one hash probe once overrides are applied, a walk of the (lazy) file tree otherwise
+        const Internal::Parser::HCValue* find(const std::string& keyPath) {
+            if (Resolved.Built()) {
+                auto entry = Resolved.Find(keyPath);
+                return entry ? entry->value : nullptr;
+            }
+            if (Lazy) return Lazy->Get(keyPath);
+            return Configuration.get(keyPath);
+        }
+
+        const Internal::Parser::HCArray* findArray(const std::string& keyPath, Internal::Parser::HCArray::Kind kind) {
+            auto val = find(keyPath);
+            auto arr = val ? val->asArray() : nullptr;
+            return arr && arr->kind == kind ? arr : nullptr;
+        }
+
+        // the tree holds the merged fragments: writing it over the main file would flatten it, over a
+        // fragment would copy everything into it. paths are compared normalized, so "./a.hc" and
+        // an absolute spelling of the same file are caught too
+        bool writesIncludedFile(const std::string& filename) const {
+            if (!Includes) return false;
+            auto path = FilesManager::NormalizePath(filename);
+            if (!path) return true;
+            if (*path == FilesManager::NormalizePath(Includes->MainFile)) return true;
+            for (const auto& file : Includes->Files) {
+                if (*path == file) return true;
+            }
+            return false;
+        }
+
+        // parses the sections a lazy load hasn't touched yet and moves everything into the tree
+        void materialize() {
+            if (!Lazy) return;
+            if (!Lazy->MaterializeAll(Configuration.root)) Loaded = false;
+            Lazy.reset();
+        }
+
+        // the view points into the tree, rebuild it whenever the tree changes
+        void refreshResolved() {
+            if (Resolved.Built()) Resolved.Build(Configuration.root, Overrides);
+        }
     };
 }
\ No newline at end of file
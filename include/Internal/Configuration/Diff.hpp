@@ -0,0 +1,68 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include "Parser.hpp"
+
+// what changed between two HotConfig trees, e.g. before and after a reload.
+// subtrees with equal structural hashes (HCValue::hash) are skipped without being walked, so the
+// cost follows the size of the change rather than the size of the config.
+namespace MF::Configurations::Internal::Parser {
+
+    struct HCChange {
+        enum class Kind { Added, Removed, Modified };
+        Kind kind;
+        // dotted key path, list elements as [n] (same syntax as HCQuery)
+        std::string path;
+    };
+
+    namespace Diff {
+        inline std::string join(const std::string& prefix, const std::string& key) {
+            return prefix.empty() ? key : prefix + "." + key;
+        }
+
+        inline void values(const HCValue& before, const HCValue& after, const std::string& path, std::vector<HCChange>& out);
+
+        inline void maps(const HCMap& before, const HCMap& after, const std::string& prefix, std::vector<HCChange>& out) {
+            std::vector<bool> matched(before.size(), false);
+            for (size_t i = 0; i < after.size(); ++i) {
+                const auto& [key, val] = after[i];
+                // keys usually keep their position, only search when they don't
+                size_t j = i;
+                if (j >= before.size() || matched[j] || !iequals(before[j].first, key)) {
+                    auto it = findCaseInsensitive(before, key);
+                    j = it == before.end() ? before.size() : static_cast<size_t>(it - before.begin());
+                }
+                if (j == before.size()) {
+                    out.push_back({HCChange::Kind::Added, join(prefix, key)});
+                    continue;
+                }
+                matched[j] = true;
+                values(before[j].second, val, join(prefix, key), out);
+            }
+            for (size_t j = 0; j < before.size(); ++j) {
+                if (!matched[j]) out.push_back({HCChange::Kind::Removed, join(prefix, before[j].first)});
+            }
+        }
+
+        inline void values(const HCValue& before, const HCValue& after, const std::string& path, std::vector<HCChange>& out) {
+            if (before.hash() == after.hash()) return;
+            if (before.isMap() && after.isMap()) {
+                maps(before.asMap(), after.asMap(), path, out);
+            } else if (before.isList() && after.isList() && before.asList().size() == after.asList().size()) {
+                const HCList& a = before.asList();
+                const HCList& b = after.asList();
+                for (size_t i = 0; i < a.size(); ++i) values(a[i], b[i], path + "[" + std::to_string(i) + "]", out);
+            } else {
+                // type changed, a scalar changed, or a list was resized
+                out.push_back({HCChange::Kind::Modified, path});
+            }
+        }
+    }
+
+    inline std::vector<HCChange> diffTrees(const HCMap& before, const HCMap& after) {
+        std::vector<HCChange> out;
+        if (hashMap(before) != hashMap(after)) Diff::maps(before, after, "", out);
+        return out;
+    }
+}
@@ -0,0 +1,241 @@
+#pragma once
+
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "Parser.hpp"
+#include "../Files/FilesManager.hpp"
+
+// `include:` directives for HotConfig.
+//
+//   Services:
+//       Logging:
+//           include: common/logging.hc      # or a list of paths
+//           Level: Debug                    # keys written here win over the fragment's
+//
+// the fragment's top-level keys are merged into the map holding the directive, in its place.
+// paths are relative to the including file, fragments may include other fragments.
+namespace MF::Configurations::Internal::Parser {
+
+    // parsed .hc files keyed by canonical path, shared by every config in the process.
+    // a file is only read again when its mtime or size changed, and only parsed again when
+    // its content hash changed too.
+    class FragmentCache {
+    public:
+        struct Stamp {
+            fs::file_time_type mtime{};
+            uintmax_t size = 0;
+            bool operator==(const Stamp& o) const { return mtime == o.mtime && size == o.size; }
+            bool operator!=(const Stamp& o) const { return !(*this == o); }
+        };
+
+        static std::optional<Stamp> StampOf(const std::string& path) {
+            std::error_code Ec;
+            Stamp stamp;
+            stamp.mtime = fs::last_write_time(fs::u8path(path), Ec);
+            if (Ec) return std::nullopt;
+            stamp.size = fs::file_size(fs::u8path(path), Ec);
+            if (Ec) return std::nullopt;
+            return stamp;
+        }
+
+        // parsed tree of `path` (canonical), nullptr if it can't be read or parsed
+        std::shared_ptr<const HCMap> Get(const std::string& path, Stamp* stampOut = nullptr) {
+            auto stamp = StampOf(path);
+            if (!stamp) return nullptr;
+            if (stampOut) *stampOut = *stamp;
+
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                auto it = entries_.find(path);
+                if (it != entries_.end() && it->second.stamp == *stamp) {
+                    ++Hits;
+                    return it->second.tree;
+                }
+            }
+
+            auto content = FilesManager::ReadFileToString(path);
+            if (!content) return nullptr;
+            size_t hash = std::hash<std::string_view>{}(*content);
+
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                auto it = entries_.find(path);
+                if (it != entries_.end() && it->second.hash == hash) {
+                    // touched but not changed
+                    it->second.stamp = *stamp;
+                    ++Hits;
+                    return it->second.tree;
+                }
+            }
+
+            HotConfig parsed;
+            if (!parsed.parseBuffer(*content)) return nullptr;
+            auto tree = std::make_shared<const HCMap>(std::move(parsed.root));
+
+            std::lock_guard<std::mutex> lock(mutex_);
+            entries_[path] = Entry{*stamp, hash, tree};
+            ++Parses;
+            return tree;
+        }
+
+        void Forget(const std::string& path) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            entries_.erase(path);
+        }
+
+        void Clear() {
+            std::lock_guard<std::mutex> lock(mutex_);
+            entries_.clear();
+        }
+
+        // counters, for diagnostics
+        size_t Parses = 0;
+        size_t Hits = 0;
+
+    private:
+        struct Entry {
+            Stamp stamp;
+            size_t hash = 0;
+            std::shared_ptr<const HCMap> tree;
+        };
+
+        std::mutex mutex_;
+        std::unordered_map<std::string, Entry> entries_;
+    };
+
+    inline FragmentCache& SharedFragmentCache() {
+        static FragmentCache cache;
+        return cache;
+    }
+
+    // fills `into` with keys from `from` it doesn't have yet, maps present in both are merged the same way
+    inline void mergeMissing(HCMap& into, const HCMap& from, size_t insertAt) {
+        for (const auto& [key, val] : from) {
+            auto it = findCaseInsensitive(into, key);
+            if (it == into.end()) {
+                into.insert(into.begin() + static_cast<std::ptrdiff_t>(insertAt), {key, val});
+                ++insertAt;
+            } else if (it->second.isMap() && val.isMap()) {
+                mergeMissing(it->second.asMap(), val.asMap(), it->second.asMap().size());
+                it->second.invalidateHash();
+            }
+        }
+    }
+
+    // a config assembled from a main file and its include fragments
+    class HCIncludes {
+    public:
+        std::string MainFile;
+        // canonical paths of every file the tree was built from, main file first
+        std::vector<std::string> Files;
+
+        explicit HCIncludes(FragmentCache& cache = SharedFragmentCache()) : cache_(&cache) {}
+
+        bool Load(HotConfig& config, const std::string& filename) {
+            auto path = FilesManager::NormalizePath(filename);
+            if (!path || !FilesManager::IsFile(*path)) return false;
+
+            std::vector<std::string> files;
+            std::vector<FragmentCache::Stamp> stamps;
+            std::vector<std::string> chain;
+            HCMap root;
+            if (!assemble(*path, root, files, stamps, chain)) return false;
+
+            config.root = std::move(root);
+            config.filename = filename;
+            MainFile = filename;
+            Files = std::move(files);
+            stamps_ = std::move(stamps);
+            return true;
+        }
+
+        // true if any file of the last Load changed on disk since
+        bool Stale() const {
+            for (size_t i = 0; i < Files.size(); ++i) {
+                auto stamp = FragmentCache::StampOf(Files[i]);
+                if (!stamp || *stamp != stamps_[i]) return true;
+            }
+            return false;
+        }
+
+        // rebuilds the tree if something changed; untouched files come out of the cache unparsed
+        bool Reload(HotConfig& config, bool* changed = nullptr) {
+            bool stale = Stale();
+            if (changed) *changed = stale;
+            if (!stale) return true;
+            return Load(config, MainFile);
+        }
+
+    private:
+        FragmentCache* cache_;
+        std::vector<FragmentCache::Stamp> stamps_;
+
+        bool assemble(const std::string& path, HCMap& out, std::vector<std::string>& files,
+                      std::vector<FragmentCache::Stamp>& stamps, std::vector<std::string>& chain) {
+            for (const auto& p : chain) {
+                if (p == path) return false; // include cycle
+            }
+
+            FragmentCache::Stamp stamp;
+            auto tree = cache_->Get(path, &stamp);
+            if (!tree) return false;
+            files.push_back(path);
+            stamps.push_back(stamp);
+
+            chain.push_back(path);
+            out = *tree;
+            bool ok = resolve(out, fs::u8path(path).parent_path(), files, stamps, chain);
+            chain.pop_back();
+            return ok;
+        }
+
+        bool resolve(HCMap& map, const fs::path& dir, std::vector<std::string>& files,
+                     std::vector<FragmentCache::Stamp>& stamps, std::vector<std::string>& chain) {
+            for (auto& [key, val] : map) {
+                if (val.isMap()) {
+                    if (!resolve(val.asMap(), dir, files, stamps, chain)) return false;
+                } else if (val.isList() && !val.isArray()) {
+                    for (auto& item : val.asList()) {
+                        if (item.isMap() && !resolve(item.asMap(), dir, files, stamps, chain)) return false;
+                        item.invalidateHash();
+                    }
+                }
+                val.invalidateHash();
+            }
+
+            auto it = findCaseInsensitive(map, "include");
+            if (it == map.end() || it->second.isMap()) return true;
+
+            std::vector<std::string> targets;
+            if (it->second.isList()) {
+                for (const auto& item : it->second.asList()) targets.push_back(item.asString());
+            } else {
+                targets.push_back(it->second.asString());
+            }
+
+            size_t at = static_cast<size_t>(it - map.begin());
+            map.erase(it);
+            for (const auto& target : targets) {
+                if (target.empty()) continue;
+                fs::path p = fs::u8path(target);
+                if (p.is_relative()) p = dir / p;
+                auto path = FilesManager::NormalizePath(p.string());
+                if (!path) return false;
+
+                HCMap fragment;
+                if (!assemble(*path, fragment, files, stamps, chain)) return false;
+                size_t before = map.size();
+                mergeMissing(map, fragment, at);
+                at += map.size() - before;
+            }
+            return true;
+        }
+    };
+}
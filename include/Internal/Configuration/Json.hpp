@@ -0,0 +1,389 @@
+#pragma once
+
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include "Parser.hpp"
+
+// JSON import/export for HotConfig trees.
+// the writer appends to one growing std::string; the reader is a single-pass recursive descent
+// that builds HCMap/HCList directly. key order is kept and lookups stay case-insensitive
+// (a key repeated with different case replaces the earlier one, like in .hc files).
+// comments have no JSON form and are dropped.
+namespace MF::Configurations::Internal::Parser {
+
+    namespace Json {
+        inline void appendEscaped(std::string& out, std::string_view s) {
+            static const char hex[] = "0123456789abcdef";
+            out += '"';
+            size_t run = 0;
+            for (size_t i = 0; i < s.size(); ++i) {
+                unsigned char c = static_cast<unsigned char>(s[i]);
+                if (c >= 0x20 && c != '"' && c != '\\') continue;
+                out.append(s.data() + run, i - run);
+                run = i + 1;
+                switch (c) {
+                    case '"':  out += "\\\""; break;
+                    case '\\': out += "\\\\"; break;
+                    case '\n': out += "\\n"; break;
+                    case '\r': out += "\\r"; break;
+                    case '\t': out += "\\t"; break;
+                    case '\b': out += "\\b"; break;
+                    case '\f': out += "\\f"; break;
+                    default:
+                        out += "\\u00";
+                        out += hex[c >> 4];
+                        out += hex[c & 0xF];
+                }
+            }
+            out.append(s.data() + run, s.size() - run);
+            out += '"';
+        }
+
+        inline void newline(std::string& out, int indent, int level) {
+            if (indent < 0) return;
+            out += '\n';
+            out.append(static_cast<size_t>(indent * level), ' ');
+        }
+
+        inline void writeValue(std::string& out, const HCValue& v, int indent, int level);
+
+        inline void writeMap(std::string& out, const HCMap& map, int indent, int level) {
+            if (map.empty()) { out += "{}"; return; }
+            out += '{';
+            for (size_t i = 0; i < map.size(); ++i) {
+                if (i) out += ',';
+                newline(out, indent, level + 1);
+                appendEscaped(out, map[i].first);
+                out += indent < 0 ? ":" : ": ";
+                writeValue(out, map[i].second, indent, level + 1);
+            }
+            newline(out, indent, level);
+            out += '}';
+        }
+
+        inline void writeValue(std::string& out, const HCValue& v, int indent, int level) {
+            if (v.isMap()) { writeMap(out, v.asMap(), indent, level); return; }
+            if (auto arr = v.asArray()) {
+                out += '[';
+                for (size_t i = 0; i < arr->size(); ++i) {
+                    if (i) out += ',';
+                    newline(out, indent, level + 1);
+                    if (arr->kind == HCArray::Kind::String) appendEscaped(out, arr->strings[i]);
+                    else if (arr->kind == HCArray::Kind::Int || std::isfinite(arr->doubles[i])) out += arr->text(i);
+                    else appendEscaped(out, arr->text(i));
+                }
+                newline(out, indent, level);
+                out += ']';
+                return;
+            }
+            if (v.isList()) {
+                const HCList& list = v.asList();
+                if (list.empty()) { out += "[]"; return; }
+                out += '[';
+                for (size_t i = 0; i < list.size(); ++i) {
+                    if (i) out += ',';
+                    newline(out, indent, level + 1);
+                    writeValue(out, list[i], indent, level + 1);
+                }
+                newline(out, indent, level);
+                out += ']';
+                return;
+            }
+
+            char buf[32];
+            switch (v.scalarKind()) {
+                case HCValue::ScalarKind::None:
+                    out += "null";
+                    return;
+                case HCValue::ScalarKind::Bool: {
+                    bool b = false;
+                    v.tryBool(b);
+                    out += b ? "true" : "false";
+                    return;
+                }
+                case HCValue::ScalarKind::Int: {
+                    std::int64_t i = 0;
+                    v.tryInt64(i);
+                    auto res = std::to_chars(buf, buf + sizeof(buf), i);
+                    out.append(buf, res.ptr);
+                    return;
+                }
+                case HCValue::ScalarKind::Double: {
+                    double d = 0.0;
+                    v.tryDouble(d);
+                    // JSON has no inf/nan, keep the text instead
+                    if (d != d || d - d != 0.0) break;
+                    auto res = std::to_chars(buf, buf + sizeof(buf), d);
+                    out.append(buf, res.ptr);
+                    return;
+                }
+                default:
+                    break;
+            }
+            if (auto text = std::get_if<std::string>(&v.value)) appendEscaped(out, *text);
+            else appendEscaped(out, v.asString());
+        }
+
+        class Reader {
+        public:
+            explicit Reader(std::string_view text) : s_(text) {}
+
+            bool document(HCMap& out) {
+                skipSpace();
+                if (!consume('{') || !object(out, 0)) return false;
+                skipSpace();
+                return pos_ == s_.size();
+            }
+
+            size_t position() const { return pos_; }
+
+        private:
+            static constexpr int MaxDepth = 512;
+            std::string_view s_;
+            size_t pos_ = 0;
+
+            void skipSpace() {
+                while (pos_ < s_.size() && (s_[pos_] == ' ' || s_[pos_] == '\n' || s_[pos_] == '\r' || s_[pos_] == '\t')) ++pos_;
+            }
+
+            bool consume(char c) {
+                if (pos_ < s_.size() && s_[pos_] == c) { ++pos_; return true; }
+                return false;
+            }
+
+            bool literal(std::string_view word) {
+                if (s_.substr(pos_, word.size()) != word) return false;
+                pos_ += word.size();
+                return true;
+            }
+
+            static void appendUtf8(std::string& out, uint32_t cp) {
+                if (cp < 0x80) {
+                    out += static_cast<char>(cp);
+                } else if (cp < 0x800) {
+                    out += static_cast<char>(0xC0 | (cp >> 6));
+                    out += static_cast<char>(0x80 | (cp & 0x3F));
+                } else if (cp < 0x10000) {
+                    out += static_cast<char>(0xE0 | (cp >> 12));
+                    out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+                    out += static_cast<char>(0x80 | (cp & 0x3F));
+                } else {
+                    out += static_cast<char>(0xF0 | (cp >> 18));
+                    out += static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+                    out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+                    out += static_cast<char>(0x80 | (cp & 0x3F));
+                }
+            }
+
+            bool hex4(uint32_t& out) {
+                if (pos_ + 4 > s_.size()) return false;
+                auto [ptr, ec] = std::from_chars(s_.data() + pos_, s_.data() + pos_ + 4, out, 16);
+                if (ec != std::errc() || ptr != s_.data() + pos_ + 4) return false;
+                pos_ += 4;
+                return true;
+            }
+
+            // opening quote already consumed
+            bool string(std::string& out) {
+                size_t run = pos_;
+                while (pos_ < s_.size()) {
+                    char c = s_[pos_];
+                    if (c == '"') {
+                        out.append(s_.data() + run, pos_ - run);
+                        ++pos_;
+                        return true;
+                    }
+                    if (static_cast<unsigned char>(c) < 0x20) return false;
+                    if (c != '\\') { ++pos_; continue; }
+
+                    out.append(s_.data() + run, pos_ - run);
+                    if (++pos_ >= s_.size()) return false;
+                    char e = s_[pos_++];
+                    switch (e) {
+                        case '"':  out += '"'; break;
+                        case '\\': out += '\\'; break;
+                        case '/':  out += '/'; break;
+                        case 'b':  out += '\b'; break;
+                        case 'f':  out += '\f'; break;
+                        case 'n':  out += '\n'; break;
+                        case 'r':  out += '\r'; break;
+                        case 't':  out += '\t'; break;
+                        case 'u': {
+                            uint32_t cp = 0;
+                            if (!hex4(cp)) return false;
+                            if (cp >= 0xD800 && cp < 0xDC00) {
+                                uint32_t low = 0;
+                                if (!literal("\\u") || !hex4(low) || low < 0xDC00 || low >= 0xE000) return false;
+                                cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+                            } else if (cp >= 0xDC00 && cp < 0xE000) {
+                                return false;
+                            }
+                            appendUtf8(out, cp);
+                            break;
+                        }
+                        default: return false;
+                    }
+                    run = pos_;
+                }
+                return false;
+            }
+
+            bool number(HCValue& out) {
+                size_t start = pos_;
+                consume('-');
+                if (pos_ >= s_.size()) return false;
+                if (s_[pos_] == '0') {
+                    ++pos_;
+                } else if (s_[pos_] >= '1' && s_[pos_] <= '9') {
+                    while (pos_ < s_.size() && std::isdigit(static_cast<unsigned char>(s_[pos_]))) ++pos_;
+                } else {
+                    return false;
+                }
+                if (consume('.')) {
+                    size_t digits = pos_;
+                    while (pos_ < s_.size() && std::isdigit(static_cast<unsigned char>(s_[pos_]))) ++pos_;
+                    if (pos_ == digits) return false;
+                }
+                if (consume('e') || consume('E')) {
+                    if (!consume('+')) consume('-');
+                    size_t digits = pos_;
+                    while (pos_ < s_.size() && std::isdigit(static_cast<unsigned char>(s_[pos_]))) ++pos_;
+                    if (pos_ == digits) return false;
+                }
+                // kept as text and typed on first use, like scalars from a .hc file
+                out = HCValue::Raw(std::string(s_.substr(start, pos_ - start)));
+                return true;
+            }
+
+            bool value(HCValue& out, int depth) {
+                skipSpace();
+                if (pos_ >= s_.size()) return false;
+                switch (s_[pos_]) {
+                    case '{': {
+                        ++pos_;
+                        out = HCValue(HCMap{});
+                        return object(out.asMap(), depth + 1);
+                    }
+                    case '[': {
+                        ++pos_;
+                        out = HCValue(HCList{});
+                        if (!array(out.asList(), depth + 1)) return false;
+                        compactList(out);
+                        return true;
+                    }
+                    case '"': {
+                        ++pos_;
+                        std::string text;
+                        if (!string(text)) return false;
+                        out = HCValue(std::move(text));
+                        return true;
+                    }
+                    case 't':
+                        if (!literal("true")) return false;
+                        out = HCValue(true);
+                        return true;
+                    case 'f':
+                        if (!literal("false")) return false;
+                        out = HCValue(false);
+                        return true;
+                    case 'n':
+                        if (!literal("null")) return false;
+                        out = HCValue();
+                        return true;
+                    default:
+                        return number(out);
+                }
+            }
+
+            static std::string folded(std::string_view key) {
+                std::string out(key);
+                for (auto& c : out) c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+                return out;
+            }
+
+            // duplicate keys replace the earlier value. small objects are searched linearly, wide ones
+            // get a folded-key index so large documents don't go quadratic
+            static void insert(HCMap& out, std::unordered_map<std::string, size_t>& index, std::string key, HCValue val) {
+                constexpr size_t IndexFrom = 16;
+                size_t at = out.size();
+                if (out.size() < IndexFrom) {
+                    auto it = findCaseInsensitive(out, key);
+                    if (it != out.end()) at = static_cast<size_t>(it - out.begin());
+                } else {
+                    if (index.empty()) {
+                        for (size_t i = 0; i < out.size(); ++i) index.emplace(folded(out[i].first), i);
+                    }
+                    auto [it, added] = index.emplace(folded(key), out.size());
+                    if (!added) at = it->second;
+                }
+                if (at < out.size()) out[at].second = std::move(val);
+                else out.emplace_back(std::move(key), std::move(val));
+            }
+
+            // opening brace already consumed
+            bool object(HCMap& out, int depth) {
+                if (depth > MaxDepth) return false;
+                std::unordered_map<std::string, size_t> index;
+                skipSpace();
+                if (consume('}')) return true;
+                while (true) {
+                    skipSpace();
+                    std::string key;
+                    if (!consume('"') || !string(key)) return false;
+                    skipSpace();
+                    if (!consume(':')) return false;
+
+                    HCValue val;
+                    if (!value(val, depth)) return false;
+                    insert(out, index, std::move(key), std::move(val));
+
+                    skipSpace();
+                    if (consume('}')) return true;
+                    if (!consume(',')) return false;
+                }
+            }
+
+            // opening bracket already consumed
+            bool array(HCList& out, int depth) {
+                if (depth > MaxDepth) return false;
+                skipSpace();
+                if (consume(']')) return true;
+                while (true) {
+                    out.emplace_back();
+                    if (!value(out.back(), depth)) return false;
+                    skipSpace();
+                    if (consume(']')) return true;
+                    if (!consume(',')) return false;
+                }
+            }
+        };
+    }
+
+    // appends the tree as JSON to `out`; indent < 0 writes it on one line
+    inline void toJson(const HCMap& root, std::string& out, int indent = -1) {
+        Json::writeMap(out, root, indent, 0);
+    }
+
+    inline std::string toJson(const HCMap& root, int indent = -1) {
+        std::string out;
+        toJson(root, out, indent);
+        return out;
+    }
+
+    // parses a JSON object into `out` (replacing its content). on failure `errorPos`, if given,
+    // gets the byte offset the reader stopped at.
+    inline bool fromJson(std::string_view text, HCMap& out, size_t* errorPos = nullptr) {
+        HCMap root;
+        Json::Reader reader(text);
+        if (!reader.document(root)) {
+            if (errorPos) *errorPos = reader.position();
+            return false;
+        }
+        out = std::move(root);
+        return true;
+    }
+}
@@ -0,0 +1,144 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "Parser.hpp"
+#include "../Files/FilesManager.hpp"
+
+// lazily parsed HotConfig document.
+// opening only indexes the top-level keys and the byte range of each section (the same split
+// parseParallel uses); a section is parsed the first time a lookup reaches it and then kept.
+// concurrent first lookups of the same section parse it once, the others wait for it.
+// since sections are only parsed on demand, a malformed section shows up as missing keys
+// instead of failing the open.
+namespace MF::Configurations::Internal::Parser {
+
+    class HCLazyDocument {
+    public:
+        // false if the text can't be split into independent sections (no key at all, a key line
+        // without ':', or a top-level key that appears twice)
+        bool Open(std::string text) {
+            text_ = std::move(text);
+            sections_.clear();
+            index_.clear();
+
+            std::string_view view(text_);
+            std::vector<size_t> starts = splitTopLevelSections(view);
+            sections_.reserve(starts.size());
+            index_.reserve(starts.size());
+            for (size_t i = 0; i < starts.size(); ++i) {
+                size_t end = i + 1 < starts.size() ? starts[i + 1] : view.size();
+                std::string_view key;
+                if (!sectionKey(view.substr(starts[i], end - starts[i]), key)) return fail();
+                auto section = std::make_unique<Section>();
+                section->key = key;
+                section->text = view.substr(starts[i], end - starts[i]);
+                if (!index_.emplace(key, sections_.size()).second) return fail();
+                sections_.push_back(std::move(section));
+            }
+            return !sections_.empty() || fail();
+        }
+
+        bool OpenFile(const std::string& filename) {
+            auto content = FilesManager::ReadFileToString(filename);
+            if (!content) return false;
+            return Open(std::move(*content));
+        }
+
+        // same lookup as HotConfig::get, parsing the top-level section it lands in if needed
+        const HCValue* Get(const std::string& keyPath) {
+            size_t dot = keyPath.find('.');
+            auto it = index_.find(std::string_view(keyPath).substr(0, dot));
+            if (it == index_.end()) return nullptr;
+            const HCMap* map = tree(*sections_[it->second]);
+            if (!map) return nullptr;
+
+            size_t pos = 0, dotPos;
+            while ((dotPos = keyPath.find('.', pos)) != std::string::npos) {
+                auto entry = findCaseInsensitive(*map, keyPath.substr(pos, dotPos - pos));
+                if (entry == map->end() || !entry->second.isMap()) return nullptr;
+                map = &entry->second.asMap();
+                pos = dotPos + 1;
+            }
+            auto entry = findCaseInsensitive(*map, keyPath.substr(pos));
+            return entry == map->end() ? nullptr : &entry->second;
+        }
+
+        size_t Sections() const { return sections_.size(); }
+
+        size_t Parsed() const {
+            size_t n = 0;
+            for (const auto& s : sections_) n += s->parsed.load(std::memory_order_acquire);
+            return n;
+        }
+
+        const std::string& Text() const { return text_; }
+
+        // parses whatever is left and moves every section into `root`, in file order.
+        // the document is empty afterwards.
+        bool MaterializeAll(HCMap& root) {
+            HCMap out;
+            out.reserve(sections_.size());
+            for (auto& s : sections_) {
+                HCMap* map = tree(*s);
+                if (!map) return false;
+                for (auto& entry : *map) out.push_back(std::move(entry));
+            }
+            root = std::move(out);
+            sections_.clear();
+            index_.clear();
+            text_.clear();
+            return true;
+        }
+
+    private:
+        struct Section {
+            std::string_view key;
+            std::string_view text;
+            std::once_flag once;
+            std::atomic<bool> parsed{false};
+            bool ok = false;
+            HCMap tree;
+        };
+
+        std::string text_;
+        std::vector<std::unique_ptr<Section>> sections_;
+        std::unordered_map<std::string_view, size_t, HCKeyHash, HCKeyEqual> index_;
+
+        bool fail() {
+            sections_.clear();
+            index_.clear();
+            return false;
+        }
+
+        // key of the first column-0 key line of a section
+        static bool sectionKey(std::string_view section, std::string_view& key) {
+            size_t pos = 0;
+            while (pos < section.size()) {
+                LineInfo info = scanLine(section.substr(pos));
+                std::string_view line = section.substr(pos, info.length);
+                pos += info.length + 1;
+                if (info.contentEnd <= info.indent || info.indent > 0 || line[0] == '-') continue;
+                if (info.colon == std::string::npos) return false;
+                key = trimView(line.substr(0, info.colon));
+                return !key.empty();
+            }
+            return false;
+        }
+
+        static HCMap* tree(Section& s) {
+            std::call_once(s.once, [&s] {
+                HotConfig parsed;
+                s.ok = parsed.parseBuffer(s.text);
+                s.tree = std::move(parsed.root);
+                s.parsed.store(true, std::memory_order_release);
+            });
+            return s.ok ? &s.tree : nullptr;
+        }
+    };
+}
@@ -0,0 +1,167 @@
+#pragma once
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "Parser.hpp"
+#include "../Runtime/Arguments/Parser.hpp"
+
+#if defined(__APPLE__)
+#include <crt_externs.h>
+#elif !defined(_WIN32)
+extern char** environ;
+#endif
+
+// override layers on top of a loaded config, lowest precedence first:
+//
+//   file          Printing:
+//                     CurrentLogLevel: Info
+//   environment   MF_CFG__Printing__CurrentLogLevel=Debug
+//   arguments     --cfg.Printing.CurrentLogLevel=Warning
+//
+// the layers are merged once into HCResolvedView, a flat case-insensitive hash of every key path,
+// so lookups afterwards are a single hash probe and never look at the layers again.
+namespace MF::Configurations::Internal::Parser {
+
+    enum class HCLayer : unsigned char { File, Environment, Arguments };
+
+    struct HCOverride {
+        std::string path;
+        HCValue value;
+        HCLayer layer;
+    };
+
+    inline constexpr std::string_view EnvironmentPrefix = "MF_CFG__";
+    inline constexpr std::string_view ArgumentPrefix = "cfg.";
+
+    // the process environment; macOS shared libraries can't see `environ` directly
+    inline char** processEnvironment() {
+#if defined(_WIN32)
+        return _environ;
+#elif defined(__APPLE__)
+        return *_NSGetEnviron();
+#else
+        return environ;
+#endif
+    }
+
+    // overrides of one layer don't come in a meaningful order (environment blocks and the
+    // argument map have none), so they are sorted by path: a parent is applied before the keys
+    // below it and the more specific override wins, whatever order they were given in
+    inline void sortOverrides(std::vector<HCOverride>& overrides) {
+        std::stable_sort(overrides.begin(), overrides.end(), [](const HCOverride& a, const HCOverride& b) {
+            return std::lexicographical_compare(a.path.begin(), a.path.end(), b.path.begin(), b.path.end(), [](char x, char y) {
+                return std::tolower(static_cast<unsigned char>(x)) < std::tolower(static_cast<unsigned char>(y));
+            });
+        });
+    }
+
+    // MF_CFG__A__B=value -> A.B
+    inline std::vector<HCOverride> CollectEnvironmentOverrides(char** env = processEnvironment()) {
+        std::vector<HCOverride> out;
+        for (char** e = env; e && *e; ++e) {
+            std::string_view entry(*e);
+            if (entry.substr(0, EnvironmentPrefix.size()) != EnvironmentPrefix) continue;
+            size_t eq = entry.find('=');
+            if (eq == std::string_view::npos || eq == EnvironmentPrefix.size()) continue;
+
+            std::string path;
+            std::string_view name = entry.substr(EnvironmentPrefix.size(), eq - EnvironmentPrefix.size());
+            for (size_t pos = 0;;) {
+                size_t sep = name.find("__", pos);
+                path.append(name.substr(pos, sep == std::string_view::npos ? std::string_view::npos : sep - pos));
+                if (sep == std::string_view::npos) break;
+                path += '.';
+                pos = sep + 2;
+            }
+            out.push_back({std::move(path), parseValue(trimView(entry.substr(eq + 1))), HCLayer::Environment});
+        }
+        sortOverrides(out);
+        return out;
+    }
+
+    // --cfg.A.B=value -> A.B (the argument parser has already lowercased the key)
+    inline std::vector<HCOverride> CollectArgumentOverrides(const Runtime::Arguments::Parser& arguments) {
+        std::vector<HCOverride> out;
+        for (const auto& [key, value] : arguments.Dump()) {
+            if (key.size() <= ArgumentPrefix.size() || key.compare(0, ArgumentPrefix.size(), ArgumentPrefix) != 0) continue;
+            out.push_back({key.substr(ArgumentPrefix.size()), parseValue(trimView(value)), HCLayer::Arguments});
+        }
+        sortOverrides(out);
+        return out;
+    }
+
+    // every key path of a tree plus overrides, flattened into one hash table.
+    // the view points into the tree and the overrides, rebuild it after changing either.
+    // keys are string_views (into keys_ for tree paths, into the overrides for theirs), so a
+    // lookup hashes the caller's string_view without building a std::string.
+    class HCResolvedView {
+    public:
+        struct Entry {
+            const HCValue* value;
+            HCLayer layer;
+        };
+
+        void Build(const HCMap& root, const std::vector<HCOverride>& overrides) {
+            entries_.clear();
+            keys_.clear();
+            entries_.reserve(count(root) + overrides.size());
+            flatten(root, std::string());
+            // later entries win, so overrides are expected in precedence order
+            for (const auto& o : overrides) {
+                auto replaced = entries_.find(std::string_view(o.path));
+                if (replaced != entries_.end() && replaced->second.value->isMap()) {
+                    // the override replaces the whole subtree that was there
+                    std::string prefix = o.path + ".";
+                    for (auto it = entries_.begin(); it != entries_.end();) {
+                        bool below = it->first.size() > prefix.size() && HCKeyEqual{}(it->first.substr(0, prefix.size()), prefix);
+                        it = below ? entries_.erase(it) : std::next(it);
+                    }
+                }
+                entries_.insert_or_assign(std::string_view(o.path), Entry{&o.value, o.layer});
+            }
+            built_ = true;
+        }
+
+        void Clear() {
+            entries_.clear();
+            keys_.clear();
+            built_ = false;
+        }
+
+        bool Built() const { return built_; }
+        size_t Size() const { return entries_.size(); }
+
+        const Entry* Find(std::string_view path) const {
+            auto it = entries_.find(path);
+            return it == entries_.end() ? nullptr : &it->second;
+        }
+
+    private:
+        std::unordered_map<std::string_view, Entry, HCKeyHash, HCKeyEqual> entries_;
+        std::deque<std::string> keys_;   // a deque doesn't move its strings as it grows
+        bool built_ = false;
+
+        static size_t count(const HCMap& map) {
+            size_t n = map.size();
+            for (const auto& [key, val] : map) {
+                if (val.isMap()) n += count(val.asMap());
+            }
+            return n;
+        }
+
+        void flatten(const HCMap& map, const std::string& prefix) {
+            for (const auto& [key, val] : map) {
+                const std::string& path = keys_.emplace_back(prefix.empty() ? key : prefix + "." + key);
+                if (val.isMap()) flatten(val.asMap(), path);
+                // first one wins, like findCaseInsensitive
+                entries_.try_emplace(std::string_view(path), Entry{&val, HCLayer::File});
+            }
+        }
+    };
+}
@@ -1,13 +1,26 @@
 #pragma once
 
 #include <string>
+#include <type_traits>
 #include <variant>
 #include <vector>
 #include <fstream>
 #include <iostream>
-#include <stack>
 #include <cctype>
+#include <cstdint>
+#include <cstring>
+#include <charconv>
+#include <limits>
+#include <algorithm>
+#include <string_view>
+#include <thread>
+#include <atomic>
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
 #include "../Files/FilesManager.hpp"
+#include "Reader.hpp"
+#include "../Time&Date/Misc.hpp"
 
 namespace MF::Configurations::Internal::Parser {
     struct HCValue;
@@ -15,8 +28,195 @@ namespace MF::Configurations::Internal::Parser {
     using HCMap = std::vector<std::pair<std::string, HCValue>>;
     using HCList = std::vector<HCValue>;
 
+    // scalar conversions, the whole (already trimmed) text has to match. no exceptions are involved.
+    inline bool parseBool(std::string_view v, bool& out) {
+        auto is = [&](std::string_view word) {
+            if (v.size() != word.size()) return false;
+            for (size_t i = 0; i < v.size(); ++i) {
+                if (std::tolower(static_cast<unsigned char>(v[i])) != word[i]) return false;
+            }
+            return true;
+        };
+        if (is("true")) { out = true; return true; }
+        if (is("false")) { out = false; return true; }
+        return false;
+    }
+
+    // decimal, optionally signed (stoi rules, but 64-bit)
+    inline bool parseInt64(std::string_view v, std::int64_t& out) {
+        if (v.size() > 1 && v[0] == '+' && v[1] != '-') v.remove_prefix(1);
+        if (v.empty()) return false;
+        auto [ptr, ec] = std::from_chars(v.data(), v.data() + v.size(), out);
+        return ec == std::errc() && ptr == v.data() + v.size();
+    }
+
+    // everything stod accepts: decimal/exponent, 0x hex floats, inf and nan, optional sign
+    inline bool parseDouble(std::string_view v, double& out) {
+        bool negative = false;
+        if (!v.empty() && (v[0] == '+' || v[0] == '-')) {
+            negative = v[0] == '-';
+            v.remove_prefix(1);
+        }
+        if (v.empty() || v[0] == '+' || v[0] == '-') return false;
+        std::chars_format fmt = std::chars_format::general;
+        if (v.size() > 2 && v[0] == '0' && (v[1] == 'x' || v[1] == 'X')) {
+            fmt = std::chars_format::hex;
+            v.remove_prefix(2);
+            if (v[0] == '+' || v[0] == '-') return false;
+        }
+        auto [ptr, ec] = std::from_chars(v.data(), v.data() + v.size(), out, fmt);
+        if (ec != std::errc() || ptr != v.data() + v.size()) return false;
+        if (negative) out = -out;
+        return true;
+    }
+
+    // Time::parseDuration syntax ("1h 30m", "250ms"). only text starting with a digit can be one,
+    // which keeps ordinary strings away from the full parser
+    inline bool parseDurationText(std::string_view v, std::int64_t& ns) {
+        if (v.empty() || !(std::isdigit(static_cast<unsigned char>(v[0])) || v[0] == '.')) return false;
+        auto d = Time::parseDuration(v);
+        if (!d) return false;
+        ns = d->count();
+        return true;
+    }
+
+    // "64MiB", "1.5 GB", "512B": decimal (kB..PB) or binary (KiB..PiB) units, case-insensitive.
+    // fractional amounts are fine when they come out as whole bytes
+    inline bool parseByteSize(std::string_view v, std::uint64_t& out) {
+        static constexpr std::pair<std::string_view, std::uint64_t> units[] = {
+            {"b", 1ULL},
+            {"kb", 1000ULL}, {"mb", 1000000ULL}, {"gb", 1000000000ULL}, {"tb", 1000000000000ULL}, {"pb", 1000000000000000ULL},
+            {"kib", 1ULL << 10}, {"mib", 1ULL << 20}, {"gib", 1ULL << 30}, {"tib", 1ULL << 40}, {"pib", 1ULL << 50},
+        };
+        size_t end = 0;
+        bool fractional = false;
+        while (end < v.size() && (std::isdigit(static_cast<unsigned char>(v[end])) || v[end] == '.')) fractional |= v[end++] == '.';
+        if (end == 0) return false;
+        std::string_view unit = trimView(v.substr(end));
+        if (unit.empty() || unit.size() > 3) return false;
+        char lower[3];
+        for (size_t i = 0; i < unit.size(); ++i) lower[i] = static_cast<char>(std::tolower(static_cast<unsigned char>(unit[i])));
+
+        for (const auto& [name, scale] : units) {
+            if (name != std::string_view(lower, unit.size())) continue;
+            if (!fractional) {
+                std::uint64_t amount = 0;
+                auto [ptr, ec] = std::from_chars(v.data(), v.data() + end, amount);
+                if (ec != std::errc() || ptr != v.data() + end || __builtin_mul_overflow(amount, scale, &out)) return false;
+                return true;
+            }
+            double amount = 0.0;
+            auto [ptr, ec] = std::from_chars(v.data(), v.data() + end, amount);
+            if (ec != std::errc() || ptr != v.data() + end) return false;
+            double bytes = amount * static_cast<double>(scale);
+            if (bytes != static_cast<double>(static_cast<std::uint64_t>(bytes)) || bytes >= 18446744073709551616.0) return false;
+            out = static_cast<std::uint64_t>(bytes);
+            return true;
+        }
+        return false;
+    }
+
+    // hashing helpers for HCValue::hash
+    inline std::uint64_t mixHash(std::uint64_t x) {
+        x ^= x >> 30;
+        x *= 0xbf58476d1ce4e5b9ULL;
+        x ^= x >> 27;
+        x *= 0x94d049bb133111ebULL;
+        x ^= x >> 31;
+        return x;
+    }
+
+    inline std::uint64_t combineHash(std::uint64_t seed, std::uint64_t v) {
+        return mixHash(seed ^ (v + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2)));
+    }
+
+    // FNV-1a, optionally folding ASCII case (map keys are looked up case-insensitively)
+    inline std::uint64_t hashText(std::string_view s, bool foldCase = false) {
+        std::uint64_t h = 0xcbf29ce484222325ULL;
+        for (unsigned char c : s) {
+            h ^= foldCase ? static_cast<unsigned char>(std::tolower(c)) : c;
+            h *= 0x100000001b3ULL;
+        }
+        return h;
+    }
+
+    // hash of a whole tree, from the (cached) hashes of its values
+    inline std::uint64_t hashMap(const HCMap& map);
+
+    // a list of plain scalars of one type (all integers, all doubles or all strings, no comments),
+    // kept as one contiguous array instead of an HCValue per element. the parser builds these while
+    // reading list items; numbers only qualify if their text is what to_chars gives back, so
+    // writing the list out reproduces the file. arrays are immutable and shared between copies of
+    // the value holding them.
+    struct HCArray {
+        enum class Kind : unsigned char { Int, Double, String };
+
+        Kind kind = Kind::String;
+        std::vector<std::int64_t> ints;
+        std::vector<double> doubles;
+        std::vector<std::string> strings;
+
+        HCArray() = default;
+        HCArray(const HCArray&) = delete;
+        HCArray& operator=(const HCArray&) = delete;
+        ~HCArray();
+
+        size_t size() const {
+            switch (kind) {
+                case Kind::Int: return ints.size();
+                case Kind::Double: return doubles.size();
+                default: return strings.size();
+            }
+        }
+
+        // text of element i as it was written
+        std::string text(size_t i) const {
+            if (kind == Kind::String) return strings[i];
+            char buf[32];
+            auto res = kind == Kind::Int ? std::to_chars(buf, buf + sizeof(buf), ints[i])
+                                         : std::to_chars(buf, buf + sizeof(buf), doubles[i]);
+            return std::string(buf, res.ptr);
+        }
+
+        // the elements as regular HCValues, for code using the generic list API.
+        // built on first use and kept; concurrent first calls are fine.
+        const HCList& list() const;
+
+    private:
+        mutable std::atomic<HCList*> expanded_{nullptr};
+    };
+
+    // read-only view of an HCArray's elements, what std::span would be in C++20
+    template <typename T>
+    class HCArrayView {
+    public:
+        HCArrayView() = default;
+        HCArrayView(const T* data, size_t size) : data_(data), size_(size) {}
+        HCArrayView(const std::vector<T>& v) : data_(v.data()), size_(v.size()) {}
+
+        const T* data() const { return data_; }
+        size_t size() const { return size_; }
+        bool empty() const { return size_ == 0; }
+        const T* begin() const { return data_; }
+        const T* end() const { return data_ + size_; }
+        const T& operator[](size_t i) const { return data_[i]; }
+
+    private:
+        const T* data_ = nullptr;
+        size_t size_ = 0;
+    };
+
     struct HCValue {
-        using ValueType = std::variant<std::monostate, bool, int, double, std::string, HCMap, HCList>;
+        using ValueType = std::variant<std::monostate, bool, int, double, std::string, HCMap, HCList, std::shared_ptr<const HCArray>>;
+        // what typed() hands out: ValueType without the compact array (expanded into an HCList),
+        // the same alternatives the public ValType has always had
+        using TypedValue = std::variant<std::monostate, bool, int, double, std::string, HCMap, HCList>;
+
+        // scalar type of a value. scalars read from a file are kept as their text and typed
+        // on first use (Unresolved until then), the result is cached.
+        // durations and byte sizes keep their text (so they are written back as they were) and are
+        // only typed for tryDuration/tryBytes; typed() hands them out as strings.
+        enum class ScalarKind : unsigned char { Unresolved, None, String, Bool, Int, Double, Duration, Bytes };
 
         ValueType value;
         std::vector<std::string> CommentsBefore;
@@ -29,15 +229,62 @@ namespace MF::Configurations::Internal::Parser {
         HCValue(std::string s) : value(std::move(s)) {}
         HCValue(HCMap m) : value(std::move(m)) {}
         HCValue(HCList l) : value(std::move(l)) {}
+        HCValue(std::shared_ptr<const HCArray> a) : value(std::move(a)) {}
+
+        // unquoted scalar text from a config file
+        static HCValue Raw(std::string text) {
+            HCValue v(std::move(text));
+            v.kind_.store(static_cast<unsigned char>(ScalarKind::Unresolved), std::memory_order_relaxed);
+            return v;
+        }
+
+        HCValue(const HCValue& o)
+            : value(o.value), CommentsBefore(o.CommentsBefore), InlineComment(o.InlineComment),
+              kind_(o.kind_.load(std::memory_order_acquire)), bits_(o.bits_.load(std::memory_order_relaxed)),
+              hash_(o.hash_.load(std::memory_order_relaxed)) {}
+        HCValue(HCValue&& o) noexcept
+            : value(std::move(o.value)), CommentsBefore(std::move(o.CommentsBefore)), InlineComment(std::move(o.InlineComment)),
+              kind_(o.kind_.load(std::memory_order_acquire)), bits_(o.bits_.load(std::memory_order_relaxed)),
+              hash_(o.hash_.load(std::memory_order_relaxed)) {}
+        HCValue& operator=(const HCValue& o) {
+            if (this != &o) *this = HCValue(o);
+            return *this;
+        }
+        HCValue& operator=(HCValue&& o) noexcept {
+            value = std::move(o.value);
+            CommentsBefore = std::move(o.CommentsBefore);
+            InlineComment = std::move(o.InlineComment);
+            bits_.store(o.bits_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            kind_.store(o.kind_.load(std::memory_order_acquire), std::memory_order_release);
+            hash_.store(o.hash_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            return *this;
+        }
 
         bool isMap() const { return std::holds_alternative<HCMap>(value); }
-        bool isList() const { return std::holds_alternative<HCList>(value); }
+        bool isList() const { return std::holds_alternative<HCList>(value) || isArray(); }
+        bool isArray() const { return std::holds_alternative<std::shared_ptr<const HCArray>>(value); }
 
         HCMap& asMap() { return std::get<HCMap>(value); }
         const HCMap& asMap() const { return std::get<HCMap>(value); }
 
-        HCList& asList() { return std::get<HCList>(value); }
-        const HCList& asList() const { return std::get<HCList>(value); }
+        // an HCArray is expanded: in place for mutable access, into its cached copy otherwise
+        HCList& asList() {
+            if (auto arr = std::get_if<std::shared_ptr<const HCArray>>(&value)) {
+                HCList list = (*arr)->list();
+                value = std::move(list);
+            }
+            return std::get<HCList>(value);
+        }
+        const HCList& asList() const {
+            if (auto arr = std::get_if<std::shared_ptr<const HCArray>>(&value)) return (*arr)->list();
+            return std::get<HCList>(value);
+        }
+
+        // the compact form of the list, nullptr if it isn't stored as one
+        const HCArray* asArray() const {
+            auto arr = std::get_if<std::shared_ptr<const HCArray>>(&value);
+            return arr ? arr->get() : nullptr;
+        }
 
         std::string asString() const {
             if (auto pval = std::get_if<std::string>(&value)) return *pval;
@@ -47,17 +294,231 @@ namespace MF::Configurations::Internal::Parser {
             return "";
         }
 
+        ScalarKind scalarKind() const {
+            auto text = std::get_if<std::string>(&value);
+            if (!text) {
+                if (std::holds_alternative<bool>(value)) return ScalarKind::Bool;
+                if (std::holds_alternative<int>(value)) return ScalarKind::Int;
+                if (std::holds_alternative<double>(value)) return ScalarKind::Double;
+                return ScalarKind::None;
+            }
+            auto kind = static_cast<ScalarKind>(kind_.load(std::memory_order_acquire));
+            if (kind != ScalarKind::Unresolved) return kind;
+
+            // racing readers compute the same result, so plain atomic stores are enough
+            bool b;
+            std::int64_t i;
+            double d;
+            std::uint64_t bits = 0;
+            if (parseBool(*text, b)) {
+                kind = ScalarKind::Bool;
+                bits = b;
+            } else if (parseInt64(*text, i)) {
+                kind = ScalarKind::Int;
+                std::memcpy(&bits, &i, sizeof(bits));
+            } else if (parseDouble(*text, d)) {
+                kind = ScalarKind::Double;
+                std::memcpy(&bits, &d, sizeof(bits));
+            } else if (parseDurationText(*text, i)) {
+                kind = ScalarKind::Duration;
+                std::memcpy(&bits, &i, sizeof(bits));
+            } else if (parseByteSize(*text, bits)) {
+                kind = ScalarKind::Bytes;
+            } else {
+                kind = ScalarKind::String;
+            }
+            bits_.store(bits, std::memory_order_relaxed);
+            kind_.store(static_cast<unsigned char>(kind), std::memory_order_release);
+            return kind;
+        }
+
+        // typed reads: the value is of that type, or its text converts to it
+        bool tryBool(bool& out) const {
+            ScalarKind kind = scalarKind();
+            if (kind == ScalarKind::Bool) {
+                if (auto p = std::get_if<bool>(&value)) out = *p;
+                else out = bits_.load(std::memory_order_relaxed) != 0;
+                return true;
+            }
+            if (kind != ScalarKind::String) return false;
+            return parseBool(trimView(std::get<std::string>(value)), out);
+        }
+
+        bool tryInt64(std::int64_t& out) const {
+            ScalarKind kind = scalarKind();
+            if (kind == ScalarKind::Int) {
+                if (auto p = std::get_if<int>(&value)) {
+                    out = *p;
+                } else {
+                    std::uint64_t bits = bits_.load(std::memory_order_relaxed);
+                    std::memcpy(&out, &bits, sizeof(out));
+                }
+                return true;
+            }
+            if (kind != ScalarKind::String) return false;
+            return parseInt64(trimView(std::get<std::string>(value)), out);
+        }
+
+        bool tryDouble(double& out) const {
+            ScalarKind kind = scalarKind();
+            if (kind == ScalarKind::Double) {
+                if (auto p = std::get_if<double>(&value)) {
+                    out = *p;
+                } else {
+                    std::uint64_t bits = bits_.load(std::memory_order_relaxed);
+                    std::memcpy(&out, &bits, sizeof(out));
+                }
+                return true;
+            }
+            if (kind == ScalarKind::Int) {
+                std::int64_t i = 0;
+                tryInt64(i);
+                out = static_cast<double>(i);
+                return true;
+            }
+            if (kind != ScalarKind::String) return false;
+            return parseDouble(trimView(std::get<std::string>(value)), out);
+        }
+
+        bool tryDuration(std::chrono::nanoseconds& out) const {
+            ScalarKind kind = scalarKind();
+            std::int64_t ns = 0;
+            if (kind == ScalarKind::Duration) {
+                std::uint64_t bits = bits_.load(std::memory_order_relaxed);
+                std::memcpy(&ns, &bits, sizeof(ns));
+            } else if (kind != ScalarKind::String || !parseDurationText(trimView(std::get<std::string>(value)), ns)) {
+                return false;
+            }
+            out = std::chrono::nanoseconds(ns);
+            return true;
+        }
+
+        // a plain non-negative integer counts as a byte count
+        bool tryBytes(std::uint64_t& out) const {
+            ScalarKind kind = scalarKind();
+            if (kind == ScalarKind::Bytes) {
+                out = bits_.load(std::memory_order_relaxed);
+                return true;
+            }
+            if (kind == ScalarKind::Int) {
+                std::int64_t i = 0;
+                tryInt64(i);
+                if (i < 0) return false;
+                out = static_cast<std::uint64_t>(i);
+                return true;
+            }
+            if (kind != ScalarKind::String) return false;
+            return parseByteSize(trimView(std::get<std::string>(value)), out);
+        }
+
+        static bool inIntRange(std::int64_t i) {
+            return i >= std::numeric_limits<int>::min() && i <= std::numeric_limits<int>::max();
+        }
+
+        // the value with file scalars resolved to bool/int/double/string, as ValType consumers expect
+        // (integers outside int range come back as double)
+        TypedValue typed() const {
+            switch (scalarKind()) {
+                case ScalarKind::Bool: { bool b = false; tryBool(b); return b; }
+                case ScalarKind::Int: {
+                    std::int64_t i = 0;
+                    tryInt64(i);
+                    if (inIntRange(i)) return static_cast<int>(i);
+                    return static_cast<double>(i);
+                }
+                case ScalarKind::Double: { double d = 0.0; tryDouble(d); return d; }
+                default:
+                    if (auto arr = asArray()) return arr->list();
+                    return std::visit([](const auto& v) -> TypedValue {
+                        if constexpr (std::is_same_v<std::decay_t<decltype(v)>, std::shared_ptr<const HCArray>>) return {};
+                        else return v;
+                    }, value);
+            }
+        }
+
         std::string getType() const {
-            if (std::holds_alternative<std::string>(value)) return "string";
-            if (std::holds_alternative<bool>(value)) return "bool";
-            if (std::holds_alternative<int>(value)) return "int";
-            if (std::holds_alternative<double>(value)) return "double";
+            switch (scalarKind()) {
+                case ScalarKind::String: return "string";
+                case ScalarKind::Bool: return "bool";
+                case ScalarKind::Int: {
+                    // like typed(): an integer too large for int is a double
+                    std::int64_t i = 0;
+                    tryInt64(i);
+                    return inIntRange(i) ? "int" : "double";
+                }
+                case ScalarKind::Double: return "double";
+                case ScalarKind::Duration: return "duration";
+                case ScalarKind::Bytes: return "bytes";
+                default: break;
+            }
             if (std::holds_alternative<HCMap>(value)) return "map";
-            if (std::holds_alternative<HCList>(value)) return "list";
+            if (isList()) return "list";
             return "unknown";
         }
+
+        // structural hash (Merkle style): scalar type and text, map keys (case-insensitive) in order,
+        // list elements in order. comments don't count. maps and lists cache theirs, so an unchanged
+        // subtree costs nothing to hash again. HotConfig::set clears the caches along the path it
+        // writes to; code editing a tree through asMap()/asList() has to call invalidateHash() on
+        // every value from the edited one up to the root.
+        std::uint64_t hash() const {
+            if (isMap() || isList()) {
+                std::uint64_t cached = hash_.load(std::memory_order_relaxed);
+                if (cached) return cached;
+            }
+
+            std::uint64_t h;
+            if (isMap()) {
+                h = hashMap(asMap());
+            } else if (auto arr = asArray()) {
+                // same result as hashing the expanded elements
+                h = 0x6c697374; // "list"
+                auto kind = arr->kind == HCArray::Kind::Int ? ScalarKind::Int : arr->kind == HCArray::Kind::Double ? ScalarKind::Double : ScalarKind::String;
+                for (size_t i = 0; i < arr->size(); ++i) {
+                    std::uint64_t text = arr->kind == HCArray::Kind::String ? hashText(arr->strings[i]) : hashText(arr->text(i));
+                    h = combineHash(h, combineHash(static_cast<std::uint64_t>(kind), text));
+                }
+            } else if (isList()) {
+                h = 0x6c697374; // "list"
+                for (const auto& item : asList()) h = combineHash(h, item.hash());
+            } else {
+                auto text = std::get_if<std::string>(&value);
+                h = combineHash(static_cast<std::uint64_t>(scalarKind()), text ? hashText(*text) : hashText(asString()));
+                return h;
+            }
+            // 0 marks "not computed"; racing readers store the same value
+            if (!h) h = 1;
+            hash_.store(h, std::memory_order_relaxed);
+            return h;
+        }
+
+        void invalidateHash() { hash_.store(0, std::memory_order_relaxed); }
+
+    private:
+        mutable std::atomic<unsigned char> kind_{static_cast<unsigned char>(ScalarKind::String)};
+        mutable std::atomic<std::uint64_t> bits_{0};
+        mutable std::atomic<std::uint64_t> hash_{0};
     };
 
+    inline std::uint64_t hashMap(const HCMap& map) {
+        std::uint64_t h = 0x6d6170; // "map"
+        for (const auto& [key, child] : map) h = combineHash(combineHash(h, hashText(key, true)), child.hash());
+        return h;
+    }
+    inline HCArray::~HCArray() { delete expanded_.load(std::memory_order_relaxed); }
+
+    inline const HCList& HCArray::list() const {
+        HCList* cached = expanded_.load(std::memory_order_acquire);
+        if (cached) return *cached;
+        auto built = std::make_unique<HCList>();
+        built->reserve(size());
+        for (size_t i = 0; i < size(); ++i) built->push_back(kind == Kind::String ? HCValue(strings[i]) : HCValue::Raw(text(i)));
+        // a racing caller may have installed its copy first, then that one is used
+        if (expanded_.compare_exchange_strong(cached, built.get(), std::memory_order_acq_rel, std::memory_order_acquire)) return *built.release();
+        return *cached;
+    }
+
+
     inline std::string trim(const std::string& s) {
         size_t start = 0;
         while (start < s.size() && std::isspace(static_cast<unsigned char>(s[start]))) ++start;
@@ -79,45 +540,154 @@ namespace MF::Configurations::Internal::Parser {
         return s.size() >= prefix.size() && s.compare(0, prefix.size(), prefix) == 0;
     }
 
-    // fix: check for quotes first, then check for the character outside quotes
-    inline size_t findUnquoted(const std::string& s, char ch, size_t start_pos = 0) {
-        size_t i = start_pos;
-        while (i < s.size()) {
-            if (s[i] == '"' || s[i] == '\'') {
-                char quote = s[i];
-                ++i;
-                while (i < s.size() && s[i] != quote) ++i;
-                if (i < s.size()) ++i;
-            } else {
-                if (s[i] == ch) return i;
-                ++i;
-            }
-        }
-        return std::string::npos;
-    }
-
-    inline HCValue parseValue(const std::string& val) {
-        std::string v = trim(val);
+    // quoted text is a string, anything else keeps its text and is typed on first use
+    inline HCValue parseValue(std::string_view val) {
+        std::string_view v = trimView(val);
         if (v.empty()) return HCValue(std::string(""));
         char first = v[0];
         if ((first == '"' || first == '\'') && v.back() == first && v.size() >= 2) {
-            return HCValue(v.substr(1, v.size() - 2));
-        }
-        if (iequals(v, "true")) return HCValue(true);
-        if (iequals(v, "false")) return HCValue(false);
-        try {
-            size_t pos;
-            int i = std::stoi(v, &pos);
-            if (pos == v.size()) return HCValue(i);
-        } catch (...) {}
-        try {
-            size_t pos;
-            double d = std::stod(v, &pos);
-            if (pos == v.size()) return HCValue(d);
-        } catch (...) {}
-        return HCValue(v);
+            return HCValue(std::string(v.substr(1, v.size() - 2)));
+        }
+        return HCValue::Raw(std::string(v));
     }
 
+    // collects list elements in HCArray form for as long as they qualify (see HCArray)
+    struct HCArrayBuilder {
+        HCArray::Kind kind = HCArray::Kind::String;
+        std::vector<std::int64_t> ints;
+        std::vector<double> doubles;
+        std::vector<std::string> strings;
+        size_t count = 0;
+        bool failed = false;
+
+        // quoted text is a string, anything else is typed like HCValue::scalarKind does.
+        // false once an element doesn't fit, and from then on
+        bool add(std::string_view text, bool quoted) {
+            if (failed) return false;
+            HCArray::Kind k = HCArray::Kind::String;
+            std::int64_t i = 0;
+            double d = 0.0;
+            bool b;
+            if (!quoted) {
+                if (parseBool(text, b)) return fail();
+                if (parseInt64(text, i)) {
+                    if (!canonical(text, i)) return fail();
+                    k = HCArray::Kind::Int;
+                } else if (parseDouble(text, d)) {
+                    if (!canonical(text, d)) return fail();
+                    k = HCArray::Kind::Double;
+                } else if (std::uint64_t bytes; parseDurationText(text, i) || parseByteSize(text, bytes)) {
+                    // typed as duration/size, which an HCArray doesn't store
+                    return fail();
+                }
+            }
+            if (count && k != kind) return fail();
+            kind = k;
+            ++count;
+            if (k == HCArray::Kind::Int) ints.push_back(i);
+            else if (k == HCArray::Kind::Double) doubles.push_back(d);
+            else strings.emplace_back(text);
+            return true;
+        }
+
+        // list item text as the reader hands it over, same rules as parseValue
+        bool addRaw(std::string_view raw) {
+            std::string_view v = trimView(raw);
+            if (v.size() >= 2 && (v[0] == '"' || v[0] == '\'') && v.back() == v[0]) return add(v.substr(1, v.size() - 2), true);
+            return add(v, v.empty());
+        }
+
+        bool add(const HCValue& v) {
+            auto text = std::get_if<std::string>(&v.value);
+            if (!text || !v.CommentsBefore.empty() || !v.InlineComment.empty()) return fail();
+            switch (v.scalarKind()) {
+                case HCValue::ScalarKind::String: return add(*text, true);
+                case HCValue::ScalarKind::Int:
+                case HCValue::ScalarKind::Double: return add(*text, false);
+                default: return fail();
+            }
+        }
+
+        // gives up on the compact form, moving what was collected into `list`
+        void spill(HCList& list) {
+            failed = true;
+            if (!count) return;
+            list.reserve(list.size() + count);
+            for (size_t n = 0; n < count; ++n) {
+                if (kind == HCArray::Kind::String) list.emplace_back(std::move(strings[n]));
+                else list.push_back(HCValue::Raw(kind == HCArray::Kind::Int ? toText(ints[n]) : toText(doubles[n])));
+            }
+            clear();
+        }
+
+        std::shared_ptr<const HCArray> finish() {
+            auto arr = std::make_shared<HCArray>();
+            arr->kind = kind;
+            arr->ints = std::move(ints);
+            arr->doubles = std::move(doubles);
+            arr->strings = std::move(strings);
+            clear();
+            return arr;
+        }
+
+    private:
+        bool fail() {
+            failed = true;
+            return false;
+        }
+
+        void clear() {
+            count = 0;
+            ints = {};
+            doubles = {};
+            strings = {};
+        }
+
+        template <typename T>
+        static std::string toText(T v) {
+            char buf[32];
+            auto res = std::to_chars(buf, buf + sizeof(buf), v);
+            return std::string(buf, res.ptr);
+        }
+
+        // only numbers that print back the same way, so saving doesn't rewrite them
+        template <typename T>
+        static bool canonical(std::string_view text, T v) {
+            char buf[32];
+            auto res = std::to_chars(buf, buf + sizeof(buf), v);
+            return std::string_view(buf, static_cast<size_t>(res.ptr - buf)) == text;
+        }
+    };
+
+    // replaces a non-empty list of plain scalars by its HCArray form. true if it did
+    inline bool compactList(HCValue& v) {
+        auto list = std::get_if<HCList>(&v.value);
+        if (!list || list->empty()) return false;
+        HCArrayBuilder items;
+        for (const auto& item : *list) {
+            if (!items.add(item)) return false;
+        }
+        v.value = items.finish();
+        return true;
+    }
+
+    // hash/equality for unordered containers keyed case-insensitively, string_view lookups included
+    struct HCKeyHash {
+        using is_transparent = void;
+        size_t operator()(std::string_view s) const { return static_cast<size_t>(hashText(s, true)); }
+    };
+
+    struct HCKeyEqual {
+        using is_transparent = void;
+        bool operator()(std::string_view a, std::string_view b) const {
+            if (a.size() != b.size()) return false;
+            for (size_t i = 0; i < a.size(); ++i) {
+                if (std::tolower(static_cast<unsigned char>(a[i])) != std::tolower(static_cast<unsigned char>(b[i]))) return false;
+            }
+            return true;
+        }
+    };
+
     inline HCMap::iterator findCaseInsensitive(HCMap& map, const std::string& key) {
         for (auto it = map.begin(); it != map.end(); ++it) {
             if (iequals(it->first, key)) return it;
@@ -132,6 +702,161 @@ namespace MF::Configurations::Internal::Parser {
         return map.cend();
     }
 
+    // a line holding nothing but whitespace and/or a comment
+    inline bool isCommentOnlyLine(std::string_view line) {
+        LineInfo info = scanLine(line);
+        return info.contentEnd <= info.indent;
+    }
+
+    // quick pass over a whole document: returns the byte offsets where top-level sections start.
+    // a section starts at a column-0 key line; comment/blank lines right above it belong to it,
+    // since parseLines attaches pending comments to the next value.
+    inline std::vector<size_t> splitTopLevelSections(std::string_view text) {
+        std::vector<size_t> starts;
+        starts.push_back(0);
+        bool seenKey = false;
+        size_t pos = 0;
+        while (pos < text.size()) {
+            size_t eol = text.find('\n', pos);
+            if (eol == std::string_view::npos) eol = text.size();
+            unsigned char first = static_cast<unsigned char>(text[pos]);
+            bool isKeyLine = eol > pos && !std::isspace(first) && first != '#' && first != '-';
+            if (isKeyLine) {
+                // the first key keeps whatever preceded it in section 0
+                if (seenKey) {
+                    size_t start = pos;
+                    while (start > starts.back()) {
+                        size_t prevEnd = start - 1; // the '\n' closing the previous line
+                        size_t nl = prevEnd == 0 ? std::string_view::npos : text.rfind('\n', prevEnd - 1);
+                        size_t prevStart = nl == std::string_view::npos ? 0 : nl + 1;
+                        if (!isCommentOnlyLine(text.substr(prevStart, prevEnd - prevStart))) break;
+                        start = prevStart;
+                    }
+                    if (start > starts.back()) starts.push_back(start);
+                }
+                seenKey = true;
+            }
+            pos = eol + 1;
+        }
+        return starts;
+    }
+
+    // HCReader consumer that builds the HCMap tree
+    struct HCTreeBuilder : HCVisitor {
+        struct Frame {
+            HCMap* map;
+            HCList* list;
+            size_t last;
+            // list frames: the value holding the list, and its items while they fit an HCArray
+            HCValue* owner = nullptr;
+            HCArrayBuilder items = {};
+            // map frames: key index, once the map is wide enough for linear search to hurt
+            std::unordered_map<std::string, size_t, HCKeyHash, HCKeyEqual> index = {};
+        };
+
+        static constexpr size_t IndexFrom = 16;
+
+        std::vector<Frame> frames;
+        std::vector<std::string> pendingComments;
+        std::string key;
+        bool keyPending = false;
+
+        explicit HCTreeBuilder(HCMap& root) { frames.push_back({&root, nullptr, 0}); }
+
+        // places the value of the current key, replacing a previous one with the same name
+        HCValue& insert(HCValue val) {
+            Frame& top = frames.back();
+            HCMap& map = *top.map;
+            size_t at = map.size();
+            if (map.size() < IndexFrom) {
+                auto it = findCaseInsensitive(map, key);
+                if (it != map.end()) at = static_cast<size_t>(it - map.begin());
+            } else {
+                if (top.index.empty()) {
+                    for (size_t i = 0; i < map.size(); ++i) top.index.emplace(map[i].first, i);
+                }
+                auto [it, added] = top.index.emplace(key, map.size());
+                if (!added) at = it->second;
+            }
+            if (at < map.size()) map[at].second = std::move(val);
+            else map.emplace_back(key, std::move(val));
+            top.last = at;
+            keyPending = false;
+            return map[at].second;
+        }
+
+        bool onComment(std::string_view text) override {
+            pendingComments.push_back("# " + std::string(text));
+            return true;
+        }
+
+        bool onKey(std::string_view k) override {
+            key.assign(k);
+            keyPending = true;
+            pendingComments.clear();
+            return true;
+        }
+
+        bool onScalar(std::string_view raw, std::string_view) override {
+            insert(parseValue(raw));
+            return true;
+        }
+
+        bool onBeginMap(std::string_view inlineComment) override {
+            Frame& top = frames.back();
+            if (top.list) {
+                top.items.spill(*top.list);
+                HCValue val = HCValue(HCMap{});
+                val.CommentsBefore = std::move(pendingComments);
+                val.InlineComment = std::string(inlineComment);
+                pendingComments.clear();
+                top.list->push_back(std::move(val));
+                frames.push_back({&top.list->back().asMap(), nullptr, 0});
+            } else {
+                frames.push_back({&insert(HCValue(HCMap{})).asMap(), nullptr, 0});
+            }
+            return true;
+        }
+
+        bool onBeginList() override {
+            Frame& top = frames.back();
+            HCValue* target;
+            if (keyPending) {
+                target = &insert(HCValue(HCList{}));
+            } else {
+                // `Key: value` followed by items, the scalar becomes the first element
+                target = &(*top.map)[top.last].second;
+                HCValue old = std::move(*target);
+                HCList list;
+                list.push_back(std::move(old));
+                *target = HCValue(std::move(list));
+            }
+            frames.push_back({nullptr, &target->asList(), 0, target});
+            // a promoted scalar stays a regular list
+            if (!frames.back().list->empty()) frames.back().items.spill(*frames.back().list);
+            return true;
+        }
+
+        bool onListItem(std::string_view raw, std::string_view inlineComment) override {
+            Frame& top = frames.back();
+            if (pendingComments.empty() && inlineComment.empty() && top.items.addRaw(raw)) return true;
+            top.items.spill(*top.list);
+            HCValue val = parseValue(raw);
+            val.CommentsBefore = std::move(pendingComments);
+            val.InlineComment = std::string(inlineComment);
+            pendingComments.clear();
+            top.list->push_back(std::move(val));
+            return true;
+        }
+
+        bool onEnd() override {
+            Frame& top = frames.back();
+            if (top.list && !top.items.failed && top.items.count) *top.owner = HCValue(top.items.finish());
+            frames.pop_back();
+            return true;
+        }
+    };
+
     struct HotConfig {
         HCMap root;
         std::string filename = "";
@@ -144,164 +869,96 @@ namespace MF::Configurations::Internal::Parser {
             return parseLines(file);
         }
 
-        bool parseLines(std::istream& stream) {
-            root.clear();
-            struct Context { int indent; HCMap* map; std::string lastKey; };
-            std::stack<Context> context;
-            context.push({-1, &root, ""});
-
-            std::vector<std::string> pendingComments;
-            std::string rawLine;
+        // same as loadFromFile, but top-level sections are parsed concurrently (see parseParallel)
+        bool loadFromFileParallel(const std::string& _filename, unsigned threads = 0, bool setFilename = true) {
+            if (!FilesManager::Exists(_filename)) return false;
+            auto content = FilesManager::ReadFileToString(_filename);
+            if (!content) return false;
+            if (setFilename) filename = _filename;
+            return parseParallel(*content, threads);
+        }
 
-            while (std::getline(stream, rawLine)) {
-                if (rawLine.empty()) continue;
+        bool parseBuffer(std::string_view text) {
+            root.clear();
+            HCTreeBuilder builder(root);
+            HCReader reader;
+            return reader.read(text, builder);
+        }
 
-                size_t indent = 0;
-                while (indent < rawLine.size() && std::isspace(static_cast<unsigned char>(rawLine[indent]))) ++indent;
+        // splits the document at top-level sections, parses groups of them on a small pool
+        // and stitches the subtrees back in file order. the result is identical to parseBuffer;
+        // whenever that can't be guaranteed (a chunk fails, or a top-level key repeats across
+        // chunks) it falls back to the sequential parser.
+        bool parseParallel(std::string_view text, unsigned threads = 0) {
+            if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
 
-                std::string content = rawLine.substr(indent);
+            std::vector<size_t> starts = threads > 1 ? splitTopLevelSections(text) : std::vector<size_t>{0};
+            if (starts.size() < 2) return parseBuffer(text);
 
-                size_t commentPos = findUnquoted(content, '#');
-                std::string inlineComment;
-                if (commentPos != std::string::npos) {
-                    inlineComment = trim(content.substr(commentPos + 1));
-                    content = content.substr(0, commentPos);
+            // group neighbouring sections into a few tasks per thread of roughly equal size
+            const size_t target = std::max<size_t>(1, text.size() / (static_cast<size_t>(threads) * 4));
+            std::vector<std::string_view> chunks;
+            size_t chunkStart = 0;
+            for (size_t i = 1; i <= starts.size(); ++i) {
+                size_t end = i < starts.size() ? starts[i] : text.size();
+                if (end - chunkStart >= target || i == starts.size()) {
+                    chunks.push_back(text.substr(chunkStart, end - chunkStart));
+                    chunkStart = end;
                 }
+            }
+            if (chunks.size() < 2) return parseBuffer(text);
 
-                std::string trimmedContent = trim(content);
-                if (trimmedContent.empty()) {
-                    if (!inlineComment.empty()) pendingComments.push_back(std::string("# ") + inlineComment);
-                    continue;
+            std::vector<HotConfig> parts(chunks.size());
+            std::atomic<size_t> next{0};
+            std::atomic<bool> failed{false};
+            auto worker = [&]() {
+                size_t i;
+                while (!failed.load(std::memory_order_relaxed) && (i = next.fetch_add(1)) < chunks.size()) {
+                    try {
+                        if (!parts[i].parseBuffer(chunks[i])) failed = true;
+                    } catch (...) {
+                        failed = true;
+                    }
                 }
+            };
 
-                if (startsWith(trimmedContent, "#")) {
-                    pendingComments.push_back(trimmedContent);
-                    continue;
-                }
+            std::vector<std::thread> pool;
+            size_t poolSize = std::min<size_t>(threads, chunks.size()) - 1;
+            pool.reserve(poolSize);
+            for (size_t t = 0; t < poolSize; ++t) pool.emplace_back(worker);
+            worker();
+            for (auto& t : pool) t.join();
 
-                while (context.size() > 1 && indent <= context.top().indent) context.pop();
-                if (context.empty()) return false;
-                HCMap* currentMap = context.top().map;
-
-                if (startsWith(content, "-")) {
-                    size_t valStart = content.find_first_not_of(" \t", 1);
-                    bool isContainerStart = false;
-                    std::string valStr;
-                    if (valStart == std::string::npos) {
-                        isContainerStart = true;
-                    } else if (content[valStart] == ':') {
-                        isContainerStart = true;
-                    } else {
-                        valStr = content.substr(valStart);
-                        isContainerStart = false;
-                    }
+            if (failed) return parseBuffer(text);
 
-                    HCValue val;
-                    if (isContainerStart) {
-                        val = HCValue(HCMap{});
-                    } else {
-                        val = parseValue(valStr);
-                    }
-                    val.CommentsBefore = std::move(pendingComments);
-                    val.InlineComment = std::move(inlineComment);
-                    pendingComments.clear();
-
-                    std::stack<Context> tmp = context;
-                    HCMap* parentMap = nullptr;
-                    std::string parentKey;
-                    while (!tmp.empty()) {
-                        const Context &c = tmp.top();
-                        if (!c.lastKey.empty()) {
-                            if (findCaseInsensitive(*c.map, c.lastKey) != c.map->end()) {
-                                parentMap = c.map;
-                                parentKey = c.lastKey;
-                                break;
-                            }
-                        }
-                        tmp.pop();
-                    }
-                    if (!parentMap) return false;
-
-                    auto it = findCaseInsensitive(*parentMap, parentKey);
-                    if (it == parentMap->end()) {
-                        HCList list;
-                        list.push_back(std::move(val));
-                        it = parentMap->emplace(parentMap->end(), parentKey, HCValue(std::move(list)));
-                    } else {
-                        auto &target = it->second;
-                        if (target.isList()) {
-                            if (isContainerStart) {
-                                target.asList().push_back(std::move(val));
-                                HCMap* newMap = &target.asList().back().asMap();
-                                context.push({static_cast<int>(indent), newMap, ""});
-                            } else {
-                                target.asList().push_back(std::move(val));
-                            }
-                        } else if (target.isMap()) {
-                            if (!target.asMap().empty()) return false;
-                            if (!context.empty() && context.top().map == &target.asMap()) context.pop();
-                            HCList list;
-                            target = HCValue(std::move(list));
-                            if (isContainerStart) {
-                                target.asList().push_back(std::move(val));
-                                HCMap* newMap = &target.asList().back().asMap();
-                                context.push({static_cast<int>(indent), newMap, ""});
-                            } else {
-                                target.asList().push_back(std::move(val));
-                            }
-                        } else {
-                            HCValue old = std::move(target);
-                            HCList list;
-                            list.push_back(std::move(old));
-                            target = HCValue(std::move(list));
-                            if (isContainerStart) {
-                                target.asList().push_back(std::move(val));
-                                HCMap* newMap = &target.asList().back().asMap();
-                                context.push({static_cast<int>(indent), newMap, ""});
-                            } else {
-                                target.asList().push_back(std::move(val));
-                            }
-                        }
-                    }
-                } else {
-                    size_t colonPos = findUnquoted(content, ':');
-                    if (colonPos == std::string::npos) return false;
-
-                    std::string key = trim(content.substr(0, colonPos));
-                    std::string valStr = content.substr(colonPos + 1);
-
-                    HCValue val;
-                    val.CommentsBefore = std::move(pendingComments);
-                    val.InlineComment = std::move(inlineComment);
-                    pendingComments.clear();
-
-                    bool isContainer = trim(valStr).empty();
-                    if (isContainer) {
-                        val = HCValue(HCMap{});
-                    } else {
-                        val = parseValue(valStr);
-                    }
+            size_t total = 0;
+            for (const auto& part : parts) total += part.root.size();
 
-                    auto it = findCaseInsensitive(*currentMap, key);
-                    if (it != currentMap->end()) {
-                        it->second = std::move(val);
-                    } else {
-                        currentMap->emplace_back(key, std::move(val));
-                    }
-
-                    context.top().lastKey = key;
-
-                    if (isContainer) {
-                        auto lastIt = --currentMap->end();
-                        HCMap* childMap = &lastIt->second.asMap();
-                        context.push({static_cast<int>(indent), childMap, ""});
-                    }
+            std::unordered_set<std::string> seen;
+            seen.reserve(total);
+            for (const auto& part : parts) {
+                for (const auto& [key, val] : part.root) {
+                    std::string lower(key);
+                    for (auto& c : lower) c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+                    if (!seen.insert(std::move(lower)).second) return parseBuffer(text);
                 }
             }
 
+            root.clear();
+            root.reserve(total);
+            for (auto& part : parts) {
+                for (auto& entry : part.root) root.push_back(std::move(entry));
+            }
             return true;
         }
 
+        bool parseLines(std::istream& stream) {
+            root.clear();
+            HCTreeBuilder builder(root);
+            HCReader reader;
+            return reader.read(stream, builder);
+        }
+
         HCValue* get(const std::string& keyPath) {
             HCMap* map = &root;
             size_t pos = 0, dotPos;
@@ -332,6 +989,7 @@ namespace MF::Configurations::Internal::Parser {
                 } else if (!it->second.isMap()) {
                     it->second = HCValue(HCMap{});
                 }
+                it->second.invalidateHash();
                 map = &(it->second.asMap());
                 pos = dotPos + 1;
             }
@@ -353,6 +1011,14 @@ namespace MF::Configurations::Internal::Parser {
                 if (val.isMap()) {
                     os << indentStr << key << ":\n";
                     writeMap(os, val.asMap(), indent + 2);
+                } else if (auto arr = val.asArray()) {
+                    os << indentStr << key << ":\n";
+                    for (size_t i = 0; i < arr->size(); ++i) {
+                        os << indentStr << "  - ";
+                        if (arr->kind == HCArray::Kind::String) os << arr->strings[i];
+                        else os << arr->text(i);
+                        os << "\n";
+                    }
                 } else if (val.isList()) {
                     os << indentStr << key << ":\n";
                     for (const auto& item : val.asList()) {
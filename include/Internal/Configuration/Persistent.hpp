@@ -0,0 +1,451 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "Parser.hpp"
+
+// persistent (immutable, structurally shared) HotConfig trees for snapshots and version history.
+// every map is a node behind a shared_ptr; changing a value copies only the nodes on the path from
+// the root to it, everything else is shared with the version it was derived from. copying an
+// HCTree is one shared_ptr copy, and a version stays valid for as long as someone holds it, no
+// matter what newer versions do.
+namespace MF::Configurations::Internal::Parser {
+
+    struct HCNode;
+    using HCNodePtr = std::shared_ptr<const HCNode>;
+
+    struct HCNode {
+        // maps: an empty value carrying the map's comments, the entries are in `children`.
+        // anything else (scalars, lists, arrays) is kept as is
+        HCValue value;
+        std::vector<std::pair<std::string, HCNodePtr>> children;
+        bool map = false;
+        // same as HCValue::hash of the value this node stands for
+        std::uint64_t hash = 0;
+    };
+
+    using HCNodeEntries = std::vector<std::pair<std::string, HCNodePtr>>;
+
+    // HCValue::hash of a map, computed from its children's node hashes
+    inline std::uint64_t hashEntries(const HCNodeEntries& children) {
+        std::uint64_t h = 0x6d6170; // "map"
+        for (const auto& [key, child] : children) h = combineHash(combineHash(h, hashText(key, true)), child->hash);
+        return h ? h : 1;
+    }
+
+    // shares identical nodes between trees, e.g. configs of many tenants that mostly hold the same
+    // sections and values. nodes are interned bottom-up, so two maps are the same once their keys
+    // (exact case), comments and child pointers are; scalars compare by type, text and comments.
+    // the table keeps what it holds alive, Purge drops nodes no tree uses anymore.
+    class HCInternTable {
+    public:
+        // the node holding a value equal to `value`, a copy of it is added if there is none yet
+        HCNodePtr Leaf(const HCValue& value) {
+            std::uint64_t hash = value.hash();
+            Shard& shard = shards_[hash % ShardCount];
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            auto [first, last] = shard.nodes.equal_range(hash);
+            for (auto it = first; it != last; ++it) {
+                const HCNode& n = *it->second;
+                if (!n.map && sameComments(n.value, value) && sameValue(n.value, value)) return it->second;
+            }
+            auto node = std::make_shared<HCNode>();
+            node->value = value;
+            node->hash = hash;
+            return shard.nodes.emplace(hash, std::move(node))->second;
+        }
+
+        // the map node with these (already interned) children and the comments of `holder`
+        HCNodePtr Map(HCNodeEntries&& children, const HCValue& holder) {
+            std::uint64_t hash = hashEntries(children);
+            Shard& shard = shards_[hash % ShardCount];
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            auto [first, last] = shard.nodes.equal_range(hash);
+            for (auto it = first; it != last; ++it) {
+                const HCNode& n = *it->second;
+                if (n.map && sameComments(n.value, holder) && sameEntries(n.children, children)) return it->second;
+            }
+            auto node = std::make_shared<HCNode>();
+            node->map = true;
+            node->value.CommentsBefore = holder.CommentsBefore;
+            node->value.InlineComment = holder.InlineComment;
+            node->children = std::move(children);
+            node->hash = hash;
+            return shard.nodes.emplace(hash, std::move(node))->second;
+        }
+
+        // returns how many nodes were dropped
+        size_t Purge() {
+            size_t dropped = 0;
+            // a node only the table refers to can't be reached by anyone else, so use_count is exact.
+            // dropping a map releases its children, which may be droppable on the next pass
+            for (size_t pass = 1; pass;) {
+                pass = 0;
+                for (auto& shard : shards_) {
+                    std::lock_guard<std::mutex> lock(shard.mutex);
+                    for (auto it = shard.nodes.begin(); it != shard.nodes.end();) {
+                        if (it->second.use_count() == 1) {
+                            it = shard.nodes.erase(it);
+                            ++pass;
+                        } else {
+                            ++it;
+                        }
+                    }
+                }
+                dropped += pass;
+            }
+            return dropped;
+        }
+
+        size_t Size() const {
+            size_t n = 0;
+            for (const auto& shard : shards_) {
+                std::lock_guard<std::mutex> lock(shard.mutex);
+                n += shard.nodes.size();
+            }
+            return n;
+        }
+
+    private:
+        static constexpr size_t ShardCount = 16;
+        struct Shard {
+            mutable std::mutex mutex;
+            std::unordered_multimap<std::uint64_t, HCNodePtr> nodes;
+        };
+        Shard shards_[ShardCount];
+
+        // children are interned first, so equal children are the same node
+        static bool sameEntries(const HCNodeEntries& a, const HCNodeEntries& b) {
+            if (a.size() != b.size()) return false;
+            for (size_t i = 0; i < a.size(); ++i) {
+                if (a[i].second != b[i].second || a[i].first != b[i].first) return false;
+            }
+            return true;
+        }
+
+        static bool sameComments(const HCValue& a, const HCValue& b) {
+            return a.CommentsBefore == b.CommentsBefore && a.InlineComment == b.InlineComment;
+        }
+
+        static bool sameValue(const HCValue& a, const HCValue& b) {
+            if (a.value.index() != b.value.index()) return false;
+            if (auto text = std::get_if<std::string>(&a.value)) return *text == std::get<std::string>(b.value) && a.scalarKind() == b.scalarKind();
+            if (auto arr = a.asArray()) {
+                const HCArray* other = b.asArray();
+                return arr == other || (arr->kind == other->kind && arr->ints == other->ints && arr->doubles == other->doubles && arr->strings == other->strings);
+            }
+            if (a.isMap()) {
+                const HCMap& x = a.asMap();
+                const HCMap& y = b.asMap();
+                if (x.size() != y.size()) return false;
+                for (size_t i = 0; i < x.size(); ++i) {
+                    if (x[i].first != y[i].first || !sameComments(x[i].second, y[i].second) || !sameValue(x[i].second, y[i].second)) return false;
+                }
+                return true;
+            }
+            if (a.isList()) {
+                const HCList& x = a.asList();
+                const HCList& y = b.asList();
+                if (x.size() != y.size()) return false;
+                for (size_t i = 0; i < x.size(); ++i) {
+                    if (!sameComments(x[i], y[i]) || !sameValue(x[i], y[i])) return false;
+                }
+                return true;
+            }
+            if (auto p = std::get_if<bool>(&a.value)) return *p == std::get<bool>(b.value);
+            if (auto p = std::get_if<int>(&a.value)) return *p == std::get<int>(b.value);
+            if (auto p = std::get_if<double>(&a.value)) return *p == std::get<double>(b.value);
+            return true;
+        }
+    };
+
+    class HCTree {
+    public:
+        HCTree() : root_(emptyMap()) {}
+
+        // builds a tree from a regular one. with `previous`, subtrees whose structural hash and
+        // comments didn't change are taken over from it instead of being copied, so committing a
+        // tree after a few HotConfig::set calls costs about as much as those sets plus one compare
+        // of the comments. new nodes go through `intern` if one is given.
+        static HCTree FromMap(const HCMap& root, const HCTree* previous = nullptr, HCInternTable* intern = nullptr) {
+            HCTree tree;
+            tree.root_ = build(root, HCValue(), previous ? previous->root_.get() : nullptr, intern);
+            return tree;
+        }
+
+        // scalars and lists; maps come back as nullptr (see node)
+        const HCValue* get(const std::string& keyPath) const {
+            const HCNode* n = node(keyPath);
+            return n && !n->map ? &n->value : nullptr;
+        }
+
+        const HCNode* node(const std::string& keyPath) const {
+            const HCNode* n = root_.get();
+            size_t pos = 0;
+            while (true) {
+                size_t dotPos = keyPath.find('.', pos);
+                auto child = find(*n, std::string_view(keyPath).substr(pos, dotPos == std::string::npos ? std::string::npos : dotPos - pos));
+                if (!child) return nullptr;
+                if (dotPos == std::string::npos) return child;
+                if (!child->map) return nullptr;
+                n = child;
+                pos = dotPos + 1;
+            }
+        }
+
+        // a new version with one value replaced or added, same rules as HotConfig::set. only the
+        // maps along the path are copied, this tree is left as it is
+        HCTree set(const std::string& keyPath, HCValue newValue) const {
+            HCTree out;
+            out.root_ = setIn(root_.get(), keyPath, 0, std::move(newValue));
+            return out;
+        }
+
+        // the tree as a regular, mutable HCMap
+        HCMap toMap() const { return toMap(*root_); }
+
+        std::uint64_t hash() const { return root_->hash; }
+        const HCNodePtr& root() const { return root_; }
+
+    private:
+        HCNodePtr root_;
+
+        static HCNodePtr emptyMap() {
+            static const HCNodePtr empty = [] {
+                auto n = std::make_shared<HCNode>();
+                n->map = true;
+                n->hash = hashEntries(n->children);
+                return n;
+            }();
+            return empty;
+        }
+
+        static const HCNode* find(const HCNode& n, std::string_view key) {
+            if (!n.map) return nullptr;
+            for (const auto& [k, child] : n.children) {
+                if (HCKeyEqual{}(k, key)) return child.get();
+            }
+            return nullptr;
+        }
+
+        static HCNodePtr build(const HCMap& map, const HCValue& holder, const HCNode* previous, HCInternTable* intern = nullptr) {
+            HCNodeEntries children;
+            children.reserve(map.size());
+            for (size_t i = 0; i < map.size(); ++i) {
+                const auto& [key, val] = map[i];
+                // keys usually keep their position between versions, only search when they don't
+                const HCNodePtr* before = nullptr;
+                if (previous && previous->map) {
+                    if (i < previous->children.size() && iequals(previous->children[i].first, key)) {
+                        before = &previous->children[i].second;
+                    } else {
+                        for (const auto& entry : previous->children) {
+                            if (iequals(entry.first, key)) { before = &entry.second; break; }
+                        }
+                    }
+                }
+                if (before && (*before)->hash == val.hash() && sameComments(**before, val)) {
+                    children.emplace_back(key, *before);
+                } else if (val.isMap()) {
+                    children.emplace_back(key, build(val.asMap(), val, before ? before->get() : nullptr, intern));
+                } else if (intern) {
+                    children.emplace_back(key, intern->Leaf(val));
+                } else {
+                    auto leaf = std::make_shared<HCNode>();
+                    leaf->value = val;
+                    leaf->hash = val.hash();
+                    children.emplace_back(key, std::move(leaf));
+                }
+            }
+            if (intern) return intern->Map(std::move(children), holder);
+
+            auto n = std::make_shared<HCNode>();
+            n->map = true;
+            n->value.CommentsBefore = holder.CommentsBefore;
+            n->value.InlineComment = holder.InlineComment;
+            n->children = std::move(children);
+            n->hash = hashEntries(n->children);
+            return n;
+        }
+
+        // comments aren't part of the hash, so a node is only reused once they match as well
+        static bool sameComments(const HCValue& a, const HCValue& b) {
+            if (a.CommentsBefore != b.CommentsBefore || a.InlineComment != b.InlineComment) return false;
+            if (a.isMap() && b.isMap()) {
+                const HCMap& x = a.asMap();
+                const HCMap& y = b.asMap();
+                if (x.size() != y.size()) return false;
+                for (size_t i = 0; i < x.size(); ++i) {
+                    if (!sameComments(x[i].second, y[i].second)) return false;
+                }
+            } else if (a.isList() && b.isList() && !(a.isArray() && b.isArray())) {
+                // compact arrays carry no comments
+                const HCList& x = a.asList();
+                const HCList& y = b.asList();
+                if (x.size() != y.size()) return false;
+                for (size_t i = 0; i < x.size(); ++i) {
+                    if (!sameComments(x[i], y[i])) return false;
+                }
+            }
+            return true;
+        }
+
+        static bool sameComments(const HCNode& n, const HCValue& val) {
+            if (!n.map) return sameComments(n.value, val);
+            if (!val.isMap() || n.value.CommentsBefore != val.CommentsBefore || n.value.InlineComment != val.InlineComment) return false;
+            const HCMap& map = val.asMap();
+            if (n.children.size() != map.size()) return false;
+            for (size_t i = 0; i < map.size(); ++i) {
+                if (!sameComments(*n.children[i].second, map[i].second)) return false;
+            }
+            return true;
+        }
+
+        static HCNodePtr setIn(const HCNode* n, const std::string& keyPath, size_t pos, HCValue&& newValue) {
+            size_t dotPos = keyPath.find('.', pos);
+            bool last = dotPos == std::string::npos;
+            std::string key = keyPath.substr(pos, last ? std::string::npos : dotPos - pos);
+
+            auto copy = std::make_shared<HCNode>();
+            copy->map = true;
+            if (n && n->map) {
+                copy->value.CommentsBefore = n->value.CommentsBefore;
+                copy->value.InlineComment = n->value.InlineComment;
+                copy->children = n->children;
+            }
+            size_t at = copy->children.size();
+            for (size_t i = 0; i < copy->children.size(); ++i) {
+                if (iequals(copy->children[i].first, key)) { at = i; break; }
+            }
+
+            HCNodePtr child;
+            if (last && newValue.isMap()) {
+                // a whole map was set, stored as nodes like everything else
+                child = build(newValue.asMap(), newValue, nullptr);
+            } else if (last) {
+                auto leaf = std::make_shared<HCNode>();
+                leaf->hash = newValue.hash();
+                leaf->value = std::move(newValue);
+                child = std::move(leaf);
+            } else {
+                // like HotConfig::set, a missing or non-map step becomes an empty map
+                const HCNode* next = at < copy->children.size() ? copy->children[at].second.get() : nullptr;
+                child = setIn(next, keyPath, dotPos + 1, std::move(newValue));
+            }
+
+            if (at < copy->children.size()) copy->children[at].second = std::move(child);
+            else copy->children.emplace_back(std::move(key), std::move(child));
+            copy->hash = hashEntries(copy->children);
+            return copy;
+        }
+
+        static HCMap toMap(const HCNode& n) {
+            HCMap out;
+            out.reserve(n.children.size());
+            for (const auto& [key, child] : n.children) {
+                if (child->map) {
+                    HCValue val(toMap(*child));
+                    val.CommentsBefore = child->value.CommentsBefore;
+                    val.InlineComment = child->value.InlineComment;
+                    out.emplace_back(key, std::move(val));
+                } else {
+                    out.emplace_back(key, child->value);
+                }
+            }
+            return out;
+        }
+    };
+
+    // the last few versions of a config, oldest dropped first. versions are numbered from 1 up.
+    // all members can be called from any thread; a tree handed out stays valid after it is dropped
+    // from the history.
+    class HCVersions {
+    public:
+        explicit HCVersions(size_t keep = 16) : keep_(keep ? keep : 1) {}
+
+        // copyable and movable so whatever holds a history (ConfigManager) stays so. a copy shares
+        // the trees, which are immutable
+        HCVersions(const HCVersions& o) {
+            std::lock_guard<std::mutex> lock(o.mutex_);
+            versions_ = o.versions_;
+            keep_ = o.keep_;
+            latest_ = o.latest_;
+        }
+        HCVersions& operator=(const HCVersions& o) {
+            if (this == &o) return *this;
+            std::scoped_lock lock(mutex_, o.mutex_);
+            versions_ = o.versions_;
+            keep_ = o.keep_;
+            latest_ = o.latest_;
+            return *this;
+        }
+        HCVersions(HCVersions&& o) noexcept {
+            std::lock_guard<std::mutex> lock(o.mutex_);
+            versions_ = std::move(o.versions_);
+            keep_ = o.keep_;
+            latest_ = o.latest_;
+        }
+        HCVersions& operator=(HCVersions&& o) noexcept {
+            if (this == &o) return *this;
+            std::scoped_lock lock(mutex_, o.mutex_);
+            versions_ = std::move(o.versions_);
+            keep_ = o.keep_;
+            latest_ = o.latest_;
+            return *this;
+        }
+
+        // records `root` as the newest version, sharing what didn't change with the current one
+        std::uint64_t Commit(const HCMap& root) {
+            HCTree current = Current();
+            return Commit(HCTree::FromMap(root, &current));
+        }
+
+        std::uint64_t Commit(HCTree tree) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            versions_.emplace_back(++latest_, std::move(tree));
+            while (versions_.size() > keep_) versions_.pop_front();
+            return latest_;
+        }
+
+        // the newest version, an empty tree before the first commit
+        HCTree Current() const {
+            std::lock_guard<std::mutex> lock(mutex_);
+            return versions_.empty() ? HCTree() : versions_.back().second;
+        }
+
+        std::optional<HCTree> At(std::uint64_t version) const {
+            std::lock_guard<std::mutex> lock(mutex_);
+            for (const auto& [number, tree] : versions_) {
+                if (number == version) return tree;
+            }
+            return std::nullopt;
+        }
+
+        // version numbers still held, oldest first
+        std::vector<std::uint64_t> Numbers() const {
+            std::lock_guard<std::mutex> lock(mutex_);
+            std::vector<std::uint64_t> out;
+            out.reserve(versions_.size());
+            for (const auto& entry : versions_) out.push_back(entry.first);
+            return out;
+        }
+
+        std::uint64_t Latest() const {
+            std::lock_guard<std::mutex> lock(mutex_);
+            return latest_;
+        }
+
+    private:
+        mutable std::mutex mutex_;
+        std::deque<std::pair<std::uint64_t, HCTree>> versions_;
+        size_t keep_ = 16;
+        std::uint64_t latest_ = 0;
+    };
+}
@@ -0,0 +1,223 @@
+#pragma once
+
+#include <charconv>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_set>
+#include <vector>
+#include "Parser.hpp"
+
+// path queries over a HotConfig tree.
+//
+//   Tenants.*.Build.Version      every tenant's version
+//   **.Enabled                   every `Enabled` key, at any depth
+//   CriticalFiles[3]             4th list element ([-1] is the last one)
+//   Mirrors[*].Url               `Url` of every map in the Mirrors list
+//
+// keys match case-insensitively, like HotConfig::get. `*` is any key of a map, `**` is zero or
+// more levels of maps and lists. a query is compiled once and can then be run on any tree, the
+// plan walks the tree in a single depth-first pass and hands out pointers into it.
+namespace MF::Configurations::Internal::Parser {
+
+    class HCQuery {
+    public:
+        // nullopt if the expression is malformed
+        static std::optional<HCQuery> Compile(std::string_view expr) {
+            HCQuery query;
+            query.expr_ = std::string(expr);
+            if (expr.empty()) return std::nullopt;
+
+            size_t pos = 0;
+            while (true) {
+                size_t end = expr.find('.', pos);
+                std::string_view segment = expr.substr(pos, end == std::string_view::npos ? std::string_view::npos : end - pos);
+                if (!query.compileSegment(segment)) return std::nullopt;
+                if (end == std::string_view::npos) break;
+                pos = end + 1;
+            }
+
+            size_t anyDepth = 0;
+            for (const auto& step : query.steps_) anyDepth += step.op == Op::AnyDepth;
+            // with two `**` the same value can be reached along several paths
+            query.dedupe_ = anyDepth > 1;
+            return query;
+        }
+
+        const std::string& Expression() const { return expr_; }
+
+        // calls fn(const HCValue&) for every match in document order, fn may return false to stop.
+        // returns false if it was stopped.
+        template <typename Fn>
+        bool Each(const HCMap& root, Fn&& fn) const {
+            return each(root, fn);
+        }
+
+        std::vector<const HCValue*> Run(const HCMap& root) const {
+            std::vector<const HCValue*> out;
+            Each(root, [&](const HCValue& v) { out.push_back(&v); });
+            return out;
+        }
+
+        // for editing the matches: compact lists on the way are expanded in this tree (asList()),
+        // never written through to the arrays other copies share
+        std::vector<HCValue*> Run(HCMap& root) const {
+            std::vector<HCValue*> out;
+            each(root, [&](HCValue& v) { out.push_back(&v); });
+            return out;
+        }
+
+        const HCValue* First(const HCMap& root) const {
+            const HCValue* found = nullptr;
+            Each(root, [&](const HCValue& v) { found = &v; return false; });
+            return found;
+        }
+
+    private:
+        enum class Op : unsigned char {
+            Key,        // name
+            AnyKey,     // *
+            AnyDepth,   // **
+            Index,      // [n]
+            AnyIndex    // [*]
+        };
+
+        struct Step {
+            Op op;
+            std::string key;
+            long long index = 0;
+        };
+
+        std::vector<Step> steps_;
+        bool dedupe_ = false;
+        std::string expr_;
+
+        bool compileSegment(std::string_view segment) {
+            size_t bracket = segment.find('[');
+            std::string_view name = segment.substr(0, bracket);
+            if (name.empty()) return false;
+            if (name == "**") {
+                if (steps_.empty() || steps_.back().op != Op::AnyDepth) steps_.push_back({Op::AnyDepth, {}});
+            } else if (name == "*") {
+                steps_.push_back({Op::AnyKey, {}});
+            } else {
+                if (name.find_first_of("*]") != std::string_view::npos) return false;
+                steps_.push_back({Op::Key, std::string(name)});
+            }
+
+            while (bracket != std::string_view::npos && bracket < segment.size()) {
+                if (segment[bracket] != '[') return false;
+                size_t close = segment.find(']', bracket);
+                if (close == std::string_view::npos) return false;
+                std::string_view inside = segment.substr(bracket + 1, close - bracket - 1);
+                if (inside == "*") {
+                    steps_.push_back({Op::AnyIndex, {}});
+                } else {
+                    long long index = 0;
+                    auto [ptr, ec] = std::from_chars(inside.data(), inside.data() + inside.size(), index);
+                    if (inside.empty() || ec != std::errc() || ptr != inside.data() + inside.size()) return false;
+                    steps_.push_back({Op::Index, {}, index});
+                }
+                bracket = close + 1;
+            }
+            return true;
+        }
+
+        // the walk below runs over a const tree (Each) or a mutable one (Run(HCMap&))
+        template <typename Map, typename Fn>
+        bool each(Map& root, Fn&& fn) const {
+            if (!dedupe_) return walkRoot(root, 0, fn);
+            std::unordered_set<const HCValue*> seen;
+            auto unique = [&](auto& v) {
+                if (!seen.insert(&v).second) return true;
+                return invoke(fn, v);
+            };
+            return walkRoot(root, 0, unique);
+        }
+
+        template <typename Fn, typename Value>
+        static bool invoke(Fn& fn, Value& v) {
+            if constexpr (std::is_void_v<decltype(fn(v))>) {
+                fn(v);
+                return true;
+            } else {
+                return static_cast<bool>(fn(v));
+            }
+        }
+
+        // the root is a bare map, it can't be a match itself
+        template <typename Map, typename Fn>
+        bool walkRoot(Map& root, size_t i, Fn& fn) const {
+            using List = std::conditional_t<std::is_const_v<Map>, const HCList, HCList>;
+            if (steps_[i].op != Op::AnyDepth) return walk(&root, static_cast<List*>(nullptr), i, fn);
+            if (i + 1 < steps_.size() && !walkRoot(root, i + 1, fn)) return false;
+            for (auto& [key, child] : root) {
+                if (!visit(child, i, fn)) return false;
+            }
+            return true;
+        }
+
+        // `v` was reached with steps [0, i) done
+        template <typename Value, typename Fn>
+        bool visit(Value& v, size_t i, Fn& fn) const {
+            using Map = std::conditional_t<std::is_const_v<Value>, const HCMap, HCMap>;
+            using List = std::conditional_t<std::is_const_v<Value>, const HCList, HCList>;
+            if (i == steps_.size()) return invoke(fn, v);
+            if (steps_[i].op != Op::AnyDepth) {
+                if (v.isMap()) return walk(&v.asMap(), static_cast<List*>(nullptr), i, fn);
+                if (v.isList()) return walk(static_cast<Map*>(nullptr), &v.asList(), i, fn);
+                return true;
+            }
+
+            if (!visit(v, i + 1, fn)) return false;
+            if (v.isMap()) {
+                for (auto& [key, child] : v.asMap()) {
+                    if (!visit(child, i, fn)) return false;
+                }
+            } else if (v.isList()) {
+                for (auto& item : v.asList()) {
+                    if (!visit(item, i, fn)) return false;
+                }
+            }
+            return true;
+        }
+
+        template <typename Map, typename List, typename Fn>
+        bool walk(Map* map, List* list, size_t i, Fn& fn) const {
+            const Step& step = steps_[i];
+            switch (step.op) {
+                case Op::Key:
+                    if (map) {
+                        auto it = findCaseInsensitive(*map, step.key);
+                        if (it != map->end()) return visit(it->second, i + 1, fn);
+                    }
+                    return true;
+                case Op::AnyKey:
+                    if (map) {
+                        for (auto& [key, child] : *map) {
+                            if (!visit(child, i + 1, fn)) return false;
+                        }
+                    }
+                    return true;
+                case Op::Index:
+                    if (list) {
+                        long long size = static_cast<long long>(list->size());
+                        long long index = step.index < 0 ? size + step.index : step.index;
+                        if (index >= 0 && index < size) return visit((*list)[static_cast<size_t>(index)], i + 1, fn);
+                    }
+                    return true;
+                case Op::AnyIndex:
+                    if (list) {
+                        for (auto& item : *list) {
+                            if (!visit(item, i + 1, fn)) return false;
+                        }
+                    }
+                    return true;
+                case Op::AnyDepth:
+                    break;
+            }
+            return true;
+        }
+    };
+}
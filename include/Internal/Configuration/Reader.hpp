@@ -0,0 +1,230 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <istream>
+#include <cctype>
+#include "Scanner.hpp"
+
+namespace MF::Configurations::Internal::Parser {
+
+    inline std::string_view trimView(std::string_view s) {
+        size_t start = 0;
+        while (start < s.size() && std::isspace(static_cast<unsigned char>(s[start]))) ++start;
+        size_t end = s.size();
+        while (end > start && std::isspace(static_cast<unsigned char>(s[end - 1]))) --end;
+        return s.substr(start, end - start);
+    }
+
+    // fix: check for quotes first, then check for the character outside quotes
+    inline size_t findUnquoted(std::string_view s, char ch, size_t start_pos = 0) {
+        size_t i = start_pos;
+        while (i < s.size()) {
+            if (s[i] == '"' || s[i] == '\'') {
+                char quote = s[i];
+                ++i;
+                while (i < s.size() && s[i] != quote) ++i;
+                if (i < s.size()) ++i;
+            } else {
+                if (s[i] == ch) return i;
+                ++i;
+            }
+        }
+        return std::string::npos;
+    }
+
+    // receives HotConfig document events from HCReader, return false from any callback to stop reading.
+    //  - every onKey is followed by its value: onScalar, onBeginMap ... onEnd or onBeginList ... onEnd
+    //  - list elements are onListItem (scalars) or onBeginMap ... onEnd (maps)
+    //  - onBeginList right after a key's onScalar means that scalar became the first element of the
+    //    list (`Key: a` followed by `- b` lines)
+    //  - onComment gets the comment text after '#', trimmed, for comment-only lines
+    // all views are only valid during the callback.
+    struct HCVisitor {
+        virtual ~HCVisitor() = default;
+        virtual bool onComment(std::string_view) { return true; }
+        virtual bool onKey(std::string_view) { return true; }
+        virtual bool onScalar(std::string_view /*raw*/, std::string_view /*inlineComment*/) { return true; }
+        virtual bool onBeginMap(std::string_view /*inlineComment*/) { return true; }
+        virtual bool onBeginList() { return true; }
+        virtual bool onListItem(std::string_view /*raw*/, std::string_view /*inlineComment*/) { return true; }
+        virtual bool onEnd() { return true; }
+    };
+
+    // streaming HotConfig reader: scans a stream or buffer line by line and reports events to a
+    // visitor. the only state kept is the indentation stack, so memory doesn't grow with the document.
+    class HCReader {
+    public:
+        bool read(std::istream& stream, HCVisitor& visitor) {
+            begin(visitor);
+            std::string rawLine;
+            while (std::getline(stream, rawLine)) {
+                if (!line(rawLine, scanLine(rawLine))) return false;
+            }
+            return finish();
+        }
+
+        bool read(std::string_view buffer, HCVisitor& visitor) {
+            begin(visitor);
+            size_t pos = 0;
+            while (pos < buffer.size()) {
+                LineInfo info = scanLine(buffer.substr(pos));
+                if (!line(buffer.substr(pos, info.length), info)) return false;
+                pos += info.length + 1;
+            }
+            return finish();
+        }
+
+        // true if the last read ended because the visitor asked for it
+        bool stopped() const { return stopped_; }
+        // 1-based line the reader stopped on (or the last line read)
+        size_t lineNumber() const { return lineNumber_; }
+
+    private:
+        // what a map's last key currently holds
+        enum class Child : unsigned char {
+            None,       // no key yet
+            Scalar,     // onScalar emitted
+            Container,  // `Key:` with an unopened frame above, could still become a map or a list
+            EmptyMap,   // `Key:` whose frame closed without children, not emitted yet
+            List,       // onBeginList emitted, list still open
+            Map         // non-empty map, already closed
+        };
+
+        struct Frame {
+            int indent;
+            bool opened;    // onBeginMap emitted
+            bool listItem;  // map is a list element
+            Child child;
+        };
+
+        HCVisitor* visitor_ = nullptr;
+        std::vector<Frame> stack_;
+        bool stopped_ = false;
+        size_t lineNumber_ = 0;
+
+        void begin(HCVisitor& visitor) {
+            visitor_ = &visitor;
+            stack_.clear();
+            stack_.push_back({-1, true, false, Child::None});
+            stopped_ = false;
+            lineNumber_ = 0;
+        }
+
+        bool emit(bool keepGoing) {
+            if (!keepGoing) stopped_ = true;
+            return keepGoing;
+        }
+
+        bool closeChild(Frame& frame) {
+            Child child = frame.child;
+            frame.child = Child::None;
+            if (child == Child::List) return emit(visitor_->onEnd());
+            if (child == Child::EmptyMap) return emit(visitor_->onBeginMap({})) && emit(visitor_->onEnd());
+            return true;
+        }
+
+        bool pop() {
+            Frame frame = stack_.back();
+            stack_.pop_back();
+            Frame& parent = stack_.back();
+            if (!frame.opened) {
+                // nothing was emitted yet, a later `- item` may still turn it into a list
+                parent.child = Child::EmptyMap;
+                return true;
+            }
+            if (!closeChild(frame) || !emit(visitor_->onEnd())) return false;
+            if (!frame.listItem) parent.child = Child::Map;
+            return true;
+        }
+
+        bool finish() {
+            while (stack_.size() > 1) {
+                if (!pop()) return false;
+            }
+            return closeChild(stack_.back());
+        }
+
+        bool line(std::string_view rawLine, const LineInfo& info) {
+            ++lineNumber_;
+            if (rawLine.empty()) return true;
+
+            size_t indent = info.indent;
+            size_t contentEnd = rawLine.size();
+            std::string_view inlineComment;
+            if (info.comment != std::string::npos) {
+                inlineComment = trimView(rawLine.substr(info.comment + 1));
+                contentEnd = info.comment;
+            }
+
+            if (info.contentEnd <= indent) {
+                if (!inlineComment.empty()) return emit(visitor_->onComment(inlineComment));
+                return true;
+            }
+
+            while (stack_.size() > 1 && static_cast<int>(indent) <= stack_.back().indent) {
+                if (!pop()) return false;
+            }
+
+            if (rawLine[indent] == '-') return listItem(rawLine.substr(indent, contentEnd - indent), indent, inlineComment);
+            if (info.colon == std::string::npos) return false;
+
+            std::string_view key = trimView(rawLine.substr(indent, info.colon - indent));
+            std::string_view valStr = trimView(rawLine.substr(info.colon + 1, info.contentEnd - info.colon - 1));
+            return keyLine(key, valStr, indent, inlineComment);
+        }
+
+        bool keyLine(std::string_view key, std::string_view valStr, size_t indent, std::string_view inlineComment) {
+            Frame& top = stack_.back();
+            if (!top.opened) {
+                top.opened = true;
+                if (!emit(visitor_->onBeginMap({}))) return false;
+            } else if (!closeChild(top)) {
+                return false;
+            }
+
+            if (!emit(visitor_->onKey(key))) return false;
+            if (valStr.empty()) {
+                top.child = Child::Container;
+                stack_.push_back({static_cast<int>(indent), false, false, Child::None});
+                return true;
+            }
+            top.child = Child::Scalar;
+            return emit(visitor_->onScalar(valStr, inlineComment));
+        }
+
+        bool listItem(std::string_view content, size_t indent, std::string_view inlineComment) {
+            size_t valStart = content.find_first_not_of(" \t", 1);
+            bool isContainerStart = valStart == std::string_view::npos || content[valStart] == ':';
+
+            // the list belongs to the closest key on the stack
+            size_t owner = stack_.size();
+            while (owner > 0 && stack_[owner - 1].child == Child::None) --owner;
+            if (owner == 0) return false;
+
+            // frames above it are keyless: either the unopened frame of the key itself
+            // (which becomes the list) or list element maps that are done
+            while (stack_.size() > owner) {
+                Frame frame = stack_.back();
+                stack_.pop_back();
+                if (!frame.opened) continue;
+                if (!closeChild(frame) || !emit(visitor_->onEnd())) return false;
+            }
+
+            Frame& parent = stack_.back();
+            if (parent.child == Child::Map) return false;
+            if (parent.child != Child::List) {
+                parent.child = Child::List;
+                if (!emit(visitor_->onBeginList())) return false;
+            }
+
+            if (isContainerStart) {
+                if (!emit(visitor_->onBeginMap(inlineComment))) return false;
+                stack_.push_back({static_cast<int>(indent), true, true, Child::None});
+                return true;
+            }
+            return emit(visitor_->onListItem(trimView(content.substr(valStart)), inlineComment));
+        }
+    };
+}
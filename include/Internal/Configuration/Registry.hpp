@@ -0,0 +1,231 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "ConfigManager.hpp"
+
+// many configs side by side, e.g. one .hc file per tenant.
+// LoadDirectory parses a whole directory in parallel. trees are kept in persistent form
+// (Persistent.hpp) with their nodes interned in one table shared by every config, so sections and
+// values that repeat across files are held once. idle configs can be evicted and changed files
+// marked by Refresh; either way the config is parsed again on its next Get.
+namespace MF::Configurations {
+    class ConfigRegistry {
+    public:
+        using Tree = Internal::Parser::HCTree;
+
+        explicit ConfigRegistry(std::string extension = ".hc") : extension_(std::move(extension)) {}
+
+        // every file with the registry's extension directly in `directory`, named after the file
+        // without extension. returns how many loaded; the names of those that didn't go to `failed`
+        size_t LoadDirectory(const std::string& directory, unsigned threads = 0, std::vector<std::string>* failed = nullptr) {
+            std::vector<std::pair<std::string, std::string>> files;
+            for (const auto& path : FilesManager::ListDirectory(directory)) {
+                fs::path p = fs::u8path(path);
+                if (p.extension() == extension_ && FilesManager::IsFile(path)) files.emplace_back(p.stem().string(), path);
+            }
+            std::sort(files.begin(), files.end());
+
+            std::vector<std::shared_ptr<Entry>> added;
+            added.reserve(files.size());
+            {
+                std::unique_lock<std::shared_mutex> lock(mutex_);
+                for (auto& [name, path] : files) {
+                    auto& slot = entries_[name];
+                    if (!slot) slot = std::make_shared<Entry>();
+                    added.push_back(slot);
+                }
+            }
+
+            if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+            std::vector<char> ok(added.size(), 0);
+            std::atomic<size_t> next{0};
+            auto worker = [&]() {
+                for (size_t i; (i = next.fetch_add(1)) < added.size();) {
+                    std::lock_guard<std::mutex> lock(added[i]->mutex);
+                    added[i]->file = files[i].second;
+                    ok[i] = load(*added[i]);
+                }
+            };
+            std::vector<std::thread> pool;
+            size_t poolSize = std::min<size_t>(threads, added.size());
+            for (size_t t = 1; t < poolSize; ++t) pool.emplace_back(worker);
+            worker();
+            for (auto& t : pool) t.join();
+
+            size_t loaded = 0;
+            for (size_t i = 0; i < added.size(); ++i) {
+                if (ok[i]) ++loaded;
+                else if (failed) failed->push_back(files[i].first);
+            }
+            return loaded;
+        }
+
+        // registers and loads a single file
+        bool Add(const std::string& name, const std::string& file) {
+            std::shared_ptr<Entry> entry;
+            {
+                std::unique_lock<std::shared_mutex> lock(mutex_);
+                auto& slot = entries_[name];
+                if (!slot) slot = std::make_shared<Entry>();
+                entry = slot;
+            }
+            std::lock_guard<std::mutex> lock(entry->mutex);
+            entry->file = file;
+            entry->tree.reset();
+            return load(*entry);
+        }
+
+        // the config's current tree, parsed again first if it was evicted or its file changed.
+        // copying a tree is O(1) and the copy stays valid whatever happens to the registry later
+        std::optional<Tree> Get(const std::string& name) {
+            auto entry = find(name);
+            if (!entry) return std::nullopt;
+            std::lock_guard<std::mutex> lock(entry->mutex);
+            if ((!entry->tree || entry->stale) && !load(*entry) && !entry->tree) return std::nullopt;
+            entry->lastUsed.store(now(), std::memory_order_relaxed);
+            return entry->tree;
+        }
+
+        // fills a ConfigManager with a copy of the config, for code that needs the whole API
+        bool Materialize(const std::string& name, ConfigManager& out) {
+            auto tree = Get(name);
+            if (!tree) return false;
+            out.Includes.reset();
+            out.Lazy.reset();
+            out.Overrides.clear();
+            out.Resolved.Clear();
+            out.Configuration.root = tree->toMap();
+            out.Configuration.filename = file(name);
+            out.Filename = out.Configuration.filename;
+            out.Loaded = true;
+            return true;
+        }
+
+        // checks every file's size and mtime and marks changed ones for reload. returns how many
+        size_t Refresh() {
+            std::shared_lock<std::shared_mutex> lock(mutex_);
+            size_t changed = 0;
+            for (auto& [name, entry] : entries_) {
+                std::lock_guard<std::mutex> entryLock(entry->mutex);
+                auto stamp = Internal::Parser::FragmentCache::StampOf(entry->file);
+                if (!entry->stamp || !stamp || *stamp != *entry->stamp) {
+                    entry->stale = true;
+                    ++changed;
+                }
+            }
+            return changed;
+        }
+
+        // drops the trees of configs no Get asked for within `idle`, then whatever interned
+        // nodes nothing uses anymore. returns how many configs were evicted
+        size_t Evict(std::chrono::steady_clock::duration idle) {
+            const std::int64_t cutoff = now() - std::chrono::duration_cast<std::chrono::nanoseconds>(idle).count();
+            size_t evicted = 0;
+            {
+                std::shared_lock<std::shared_mutex> lock(mutex_);
+                for (auto& [name, entry] : entries_) {
+                    std::lock_guard<std::mutex> entryLock(entry->mutex);
+                    if (entry->tree && entry->lastUsed.load(std::memory_order_relaxed) < cutoff) {
+                        entry->tree.reset();
+                        ++evicted;
+                    }
+                }
+            }
+            if (evicted) intern_.Purge();
+            return evicted;
+        }
+
+        bool Remove(const std::string& name) {
+            {
+                std::unique_lock<std::shared_mutex> lock(mutex_);
+                if (!entries_.erase(name)) return false;
+            }
+            intern_.Purge();
+            return true;
+        }
+
+        std::vector<std::string> Names() const {
+            std::shared_lock<std::shared_mutex> lock(mutex_);
+            std::vector<std::string> out;
+            out.reserve(entries_.size());
+            for (const auto& [name, entry] : entries_) out.push_back(name);
+            std::sort(out.begin(), out.end());
+            return out;
+        }
+
+        size_t Size() const {
+            std::shared_lock<std::shared_mutex> lock(mutex_);
+            return entries_.size();
+        }
+
+        // configs currently held in memory (not evicted)
+        size_t Resident() const {
+            std::shared_lock<std::shared_mutex> lock(mutex_);
+            size_t n = 0;
+            for (const auto& [name, entry] : entries_) {
+                std::lock_guard<std::mutex> entryLock(entry->mutex);
+                n += entry->tree.has_value();
+            }
+            return n;
+        }
+
+        Internal::Parser::HCInternTable& InternTable() { return intern_; }
+
+    private:
+        struct Entry {
+            std::string file;
+            mutable std::mutex mutex;
+            std::optional<Tree> tree;
+            std::optional<Internal::Parser::FragmentCache::Stamp> stamp;
+            bool stale = false;
+            std::atomic<std::int64_t> lastUsed{0};
+        };
+
+        std::string extension_;
+        mutable std::shared_mutex mutex_;
+        std::unordered_map<std::string, std::shared_ptr<Entry>> entries_;
+        Internal::Parser::HCInternTable intern_;
+
+        static std::int64_t now() {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+        }
+
+        // entries are shared so one being used can be removed from the registry meanwhile
+        std::shared_ptr<Entry> find(const std::string& name) const {
+            std::shared_lock<std::shared_mutex> lock(mutex_);
+            auto it = entries_.find(name);
+            return it == entries_.end() ? nullptr : it->second;
+        }
+
+        std::string file(const std::string& name) const {
+            auto entry = find(name);
+            if (!entry) return "";
+            std::lock_guard<std::mutex> lock(entry->mutex);
+            return entry->file;
+        }
+
+        // entry->mutex held. a failed reload keeps the tree that was there
+        bool load(Entry& entry) {
+            auto stamp = Internal::Parser::FragmentCache::StampOf(entry.file);
+            Internal::Parser::HotConfig parsed;
+            if (!stamp || !parsed.loadFromFile(entry.file, false)) return false;
+            const Tree* previous = entry.tree ? &*entry.tree : nullptr;
+            entry.tree = Tree::FromMap(parsed.root, previous, &intern_);
+            entry.stamp = stamp;
+            entry.stale = false;
+            entry.lastUsed.store(now(), std::memory_order_relaxed);
+            return true;
+        }
+    };
+}
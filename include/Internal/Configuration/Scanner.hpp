@@ -0,0 +1,249 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || (defined(__i386__) && defined(__SSE2__)))
+#define MF_HC_SCAN_X86 1
+#include <immintrin.h>
+#endif
+
+// HotConfig line scanner: finds, in one pass, everything the reader needs from a raw line.
+// the SIMD versions classify 64 bytes at a time into bitmasks (newline, quotes, '#', ':',
+// whitespace) and resolve quoted regions with a prefix-xor, simdjson style. blocks mixing
+// both quote kinds fall back to the byte loop, so results always match findUnquoted/trim.
+namespace MF::Configurations::Internal::Parser {
+
+    struct LineInfo {
+        size_t length = 0;                        // bytes before '\n' (or the end of the input)
+        size_t indent = 0;                        // leading whitespace
+        size_t comment = std::string::npos;       // first unquoted '#'
+        size_t colon = std::string::npos;         // first unquoted ':' before the comment
+        size_t contentEnd = 0;                    // one past the last non-space byte before the comment, >= indent
+    };
+
+    enum class ScanISA { Scalar, SSE2, AVX2 };
+
+    inline const char* ScanISAName(ScanISA isa) {
+        switch (isa) {
+            case ScanISA::Scalar: return "scalar";
+            case ScanISA::SSE2:   return "sse2";
+            case ScanISA::AVX2:   return "avx2";
+        }
+        return "unknown";
+    }
+
+    namespace Scan {
+        // same set as std::isspace in the "C" locale
+        inline bool isSpace(unsigned char c) { return c == ' ' || (c >= '\t' && c <= '\r'); }
+
+        struct Masks { uint64_t newline, dquote, squote, hash, colon, space; };
+
+        // bit i = parity of set bits at positions <= i
+        inline uint64_t prefixXor(uint64_t x) {
+            x ^= x << 1;
+            x ^= x << 2;
+            x ^= x << 4;
+            x ^= x << 8;
+            x ^= x << 16;
+            x ^= x << 32;
+            return x;
+        }
+
+        // byte loop, picks up at `pos` with the given quote state
+        inline void scanScalar(const char* p, size_t n, size_t pos, char quote, bool inIndent, LineInfo& info) {
+            for (; pos < n; ++pos) {
+                char c = p[pos];
+                if (c == '\n') break;
+                bool space = isSpace(static_cast<unsigned char>(c));
+                if (inIndent) {
+                    if (space) { info.indent = pos + 1; continue; }
+                    inIndent = false;
+                }
+                if (info.comment != std::string::npos) continue;
+                if (quote) {
+                    if (c == quote) quote = 0;
+                } else if (c == '"' || c == '\'') {
+                    quote = c;
+                } else if (c == '#') {
+                    info.comment = pos;
+                    continue;
+                } else if (c == ':' && info.colon == std::string::npos) {
+                    info.colon = pos;
+                }
+                if (!space) info.contentEnd = pos + 1;
+            }
+            info.length = pos;
+            if (info.contentEnd < info.indent) info.contentEnd = info.indent;
+        }
+
+        inline int ctz(uint64_t x) { return __builtin_ctzll(x); }
+        inline int clz(uint64_t x) { return __builtin_clzll(x); }
+
+        template <typename Classify>
+        inline LineInfo scanBlocks(const char* p, size_t n, Classify classify) {
+            LineInfo info;
+            char quote = 0;
+            bool inIndent = true;
+            alignas(64) char tail[64];
+
+            for (size_t off = 0; off < n; off += 64) {
+                size_t rem = n - off;
+                const char* block = p + off;
+                uint64_t valid = ~uint64_t(0);
+                if (rem < 64) {
+                    std::memset(tail, 0, sizeof(tail));
+                    std::memcpy(tail, block, rem);
+                    block = tail;
+                    valid = (uint64_t(1) << rem) - 1;
+                }
+
+                Masks m = classify(block);
+                bool lastBlock = rem <= 64;
+                if (m.newline & valid) {
+                    int nl = ctz(m.newline & valid);
+                    valid &= (uint64_t(1) << nl) - 1;
+                    info.length = off + static_cast<size_t>(nl);
+                    lastBlock = true;
+                } else if (lastBlock) {
+                    info.length = n;
+                }
+
+                if (inIndent) {
+                    uint64_t solid = ~m.space & valid;
+                    if (solid) {
+                        info.indent = off + static_cast<size_t>(ctz(solid));
+                        inIndent = false;
+                    } else {
+                        info.indent = off + static_cast<size_t>(__builtin_popcountll(valid));
+                    }
+                }
+
+                if (info.comment == std::string::npos) {
+                    uint64_t dq = m.dquote & valid, sq = m.squote & valid;
+                    uint64_t region;
+                    if (!quote && !dq && !sq) {
+                        region = 0;
+                    } else if (!quote && (!dq || !sq)) {
+                        quote = dq ? '"' : '\'';
+                        region = prefixXor(dq | sq);
+                    } else if (quote && !(quote == '"' ? sq : dq)) {
+                        region = ~prefixXor(quote == '"' ? dq : sq);
+                    } else if (quote && !(quote == '"' ? dq : sq)) {
+                        region = ~uint64_t(0); // the other kind is literal inside the open quote
+                    } else {
+                        // both kinds in play, resolve the rest of the line byte by byte
+                        scanScalar(p, n, off, quote, inIndent, info);
+                        return info;
+                    }
+
+                    uint64_t hash = m.hash & valid & ~region;
+                    uint64_t colon = m.colon & valid & ~region;
+                    uint64_t solid = ~m.space & valid;
+                    if (hash) {
+                        uint64_t before = (uint64_t(1) << ctz(hash)) - 1;
+                        info.comment = off + static_cast<size_t>(ctz(hash));
+                        colon &= before;
+                        solid &= before;
+                    }
+                    if (colon && info.colon == std::string::npos) info.colon = off + static_cast<size_t>(ctz(colon));
+                    if (solid) info.contentEnd = off + 64 - static_cast<size_t>(clz(solid));
+                    if (!(region >> 63)) quote = 0;
+                }
+
+                if (lastBlock) break;
+            }
+            if (info.contentEnd < info.indent) info.contentEnd = info.indent;
+            return info;
+        }
+
+#ifdef MF_HC_SCAN_X86
+        inline uint64_t movemask16(__m128i v) { return static_cast<uint32_t>(_mm_movemask_epi8(v)) & 0xFFFFu; }
+
+        inline Masks classifySSE2(const char* p) {
+            Masks m{0, 0, 0, 0, 0, 0};
+            const __m128i nl = _mm_set1_epi8('\n'), dq = _mm_set1_epi8('"'), sq = _mm_set1_epi8('\'');
+            const __m128i hs = _mm_set1_epi8('#'), cl = _mm_set1_epi8(':'), sp = _mm_set1_epi8(' ');
+            const __m128i tab = _mm_set1_epi8('\t'), four = _mm_set1_epi8(4);
+            for (int i = 0; i < 4; ++i) {
+                __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i * 16));
+                __m128i ctl = _mm_sub_epi8(v, tab); // '\t'..'\r' -> 0..4
+                __m128i space = _mm_or_si128(_mm_cmpeq_epi8(v, sp), _mm_cmpeq_epi8(_mm_min_epu8(ctl, four), ctl));
+                int shift = i * 16;
+                m.newline |= movemask16(_mm_cmpeq_epi8(v, nl)) << shift;
+                m.dquote  |= movemask16(_mm_cmpeq_epi8(v, dq)) << shift;
+                m.squote  |= movemask16(_mm_cmpeq_epi8(v, sq)) << shift;
+                m.hash    |= movemask16(_mm_cmpeq_epi8(v, hs)) << shift;
+                m.colon   |= movemask16(_mm_cmpeq_epi8(v, cl)) << shift;
+                m.space   |= movemask16(space) << shift;
+            }
+            return m;
+        }
+
+        __attribute__((target("avx2"))) inline uint64_t movemask32(__m256i v) {
+            return static_cast<uint32_t>(_mm256_movemask_epi8(v));
+        }
+
+        __attribute__((target("avx2"))) inline Masks classifyAVX2(const char* p) {
+            Masks m{0, 0, 0, 0, 0, 0};
+            const __m256i nl = _mm256_set1_epi8('\n'), dq = _mm256_set1_epi8('"'), sq = _mm256_set1_epi8('\'');
+            const __m256i hs = _mm256_set1_epi8('#'), cl = _mm256_set1_epi8(':'), sp = _mm256_set1_epi8(' ');
+            const __m256i tab = _mm256_set1_epi8('\t'), four = _mm256_set1_epi8(4);
+            for (int i = 0; i < 2; ++i) {
+                __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i * 32));
+                __m256i ctl = _mm256_sub_epi8(v, tab);
+                __m256i space = _mm256_or_si256(_mm256_cmpeq_epi8(v, sp), _mm256_cmpeq_epi8(_mm256_min_epu8(ctl, four), ctl));
+                int shift = i * 32;
+                m.newline |= movemask32(_mm256_cmpeq_epi8(v, nl)) << shift;
+                m.dquote  |= movemask32(_mm256_cmpeq_epi8(v, dq)) << shift;
+                m.squote  |= movemask32(_mm256_cmpeq_epi8(v, sq)) << shift;
+                m.hash    |= movemask32(_mm256_cmpeq_epi8(v, hs)) << shift;
+                m.colon   |= movemask32(_mm256_cmpeq_epi8(v, cl)) << shift;
+                m.space   |= movemask32(space) << shift;
+            }
+            return m;
+        }
+#endif
+    }
+
+    inline bool ScanISASupported(ScanISA isa) {
+        switch (isa) {
+            case ScanISA::Scalar: return true;
+#ifdef MF_HC_SCAN_X86
+            case ScanISA::SSE2: return true;
+            case ScanISA::AVX2: return __builtin_cpu_supports("avx2");
+#else
+            default: return false;
+#endif
+        }
+        return false;
+    }
+
+    inline ScanISA BestScanISA() {
+        if (ScanISASupported(ScanISA::AVX2)) return ScanISA::AVX2;
+        if (ScanISASupported(ScanISA::SSE2)) return ScanISA::SSE2;
+        return ScanISA::Scalar;
+    }
+
+    // scans one line starting at s.data(), stopping at the first '\n'
+    inline LineInfo scanLine(std::string_view s, ScanISA isa) {
+        switch (isa) {
+#ifdef MF_HC_SCAN_X86
+            case ScanISA::SSE2: return Scan::scanBlocks(s.data(), s.size(), Scan::classifySSE2);
+            case ScanISA::AVX2: return Scan::scanBlocks(s.data(), s.size(), Scan::classifyAVX2);
+#endif
+            default: {
+                LineInfo info;
+                Scan::scanScalar(s.data(), s.size(), 0, 0, true, info);
+                return info;
+            }
+        }
+    }
+
+    inline LineInfo scanLine(std::string_view s) {
+        static const ScanISA isa = BestScanISA();
+        return scanLine(s, isa);
+    }
+}
@@ -0,0 +1,594 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "Parser.hpp"
+
+#ifndef _WIN32
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// read-only HotConfig snapshots that can be mapped and read in place.
+// a snapshot is one flat buffer: a header, then nodes, strings and child tables, all referring to
+// each other by offset from the start of the buffer, so it reads the same wherever it is mapped.
+// scalars carry their resolved type and value, map keys are indexed for binary search, comments
+// are left out.
+//
+// HCSharedPublisher writes snapshots into POSIX shared memory and HCSharedReader maps them in
+// other processes: every Publish goes into a new segment "<name>.<generation>" and then bumps the
+// generation in the small control segment "<name>". readers see the new generation on their next
+// Current() and keep using the snapshot they hold until they let go of it.
+namespace MF::Configurations::Internal::Parser {
+
+    struct HCSnapshotHeader {
+        static constexpr char Magic[8] = {'H', 'C', 'S', 'N', 'A', 'P', '\0', '\0'};
+        static constexpr std::uint32_t Layout = 1;
+
+        char magic[8];
+        std::uint32_t layout;
+        std::uint32_t root;
+        std::uint64_t size;
+        std::uint64_t version;
+        std::uint64_t generation;
+        std::uint64_t hash;
+    };
+
+    struct HCSnapshotNode {
+        enum class Type : std::uint8_t { None, Scalar, Map, List };
+
+        Type type;
+        HCValue::ScalarKind kind;
+        // bool/int/double set in code rather than read from text
+        std::uint8_t native;
+        std::uint8_t reserved;
+        // map entries or list items
+        std::uint32_t count;
+        // scalar text, or the map entry table / list item table
+        std::uint32_t offset;
+        std::uint32_t length;
+        // the scalar's resolved value (see HCValue::scalarKind)
+        std::uint64_t bits;
+    };
+
+    struct HCSnapshotEntry {
+        std::uint32_t key;
+        std::uint32_t keyLength;
+        std::uint32_t node;
+    };
+
+    // serializes a tree. values are typed here once, so readers never parse anything
+    class HCSnapshotWriter {
+    public:
+        static std::string Write(const HCMap& root, std::uint64_t version = 0, std::uint64_t generation = 0) {
+            HCSnapshotWriter writer;
+            writer.out_.resize(sizeof(HCSnapshotHeader));
+            std::uint32_t rootNode = writer.map(root);
+
+            HCSnapshotHeader header{};
+            std::memcpy(header.magic, HCSnapshotHeader::Magic, sizeof(header.magic));
+            header.layout = HCSnapshotHeader::Layout;
+            header.root = rootNode;
+            header.size = writer.out_.size();
+            header.version = version;
+            header.generation = generation;
+            header.hash = hashMap(root);
+            std::memcpy(writer.out_.data(), &header, sizeof(header));
+            return std::move(writer.out_);
+        }
+
+        // the order map keys are indexed in: ASCII-lowercased bytes (what std::tolower does in
+        // the "C" locale the parser runs in, without the call per character)
+        static int compareKeys(std::string_view a, std::string_view b) {
+            auto fold = [](char c) { return c >= 'A' && c <= 'Z' ? c + 32 : static_cast<unsigned char>(c); };
+            size_t n = std::min(a.size(), b.size());
+            for (size_t i = 0; i < n; ++i) {
+                int ca = fold(a[i]);
+                int cb = fold(b[i]);
+                if (ca != cb) return ca < cb ? -1 : 1;
+            }
+            return a.size() == b.size() ? 0 : a.size() < b.size() ? -1 : 1;
+        }
+
+    private:
+        std::string out_;
+        std::unordered_map<std::string, std::uint32_t> strings_;
+
+        std::uint32_t align(size_t to) {
+            out_.resize((out_.size() + to - 1) / to * to, '\0');
+            if (out_.size() > UINT32_MAX) throw std::length_error("HotConfig snapshot larger than 4 GiB");
+            return static_cast<std::uint32_t>(out_.size());
+        }
+
+        template <typename T>
+        std::uint32_t append(const T* items, size_t n) {
+            std::uint32_t at = align(alignof(T));
+            out_.append(reinterpret_cast<const char*>(items), n * sizeof(T));
+            return at;
+        }
+
+        // keys and repeated texts are stored once
+        std::uint32_t text(const std::string& s) {
+            auto it = strings_.find(s);
+            if (it != strings_.end()) return it->second;
+            std::uint32_t at = static_cast<std::uint32_t>(out_.size());
+            out_.append(s);
+            strings_.emplace(s, at);
+            return at;
+        }
+
+        std::uint32_t scalar(const HCValue& value) {
+            HCSnapshotNode node{};
+            node.type = HCSnapshotNode::Type::Scalar;
+            node.kind = value.scalarKind();
+            node.native = !std::holds_alternative<std::string>(value.value);
+            std::string s = value.asString();
+            node.offset = text(s);
+            node.length = static_cast<std::uint32_t>(s.size());
+
+            bool b = false;
+            std::int64_t i = 0;
+            double d = 0.0;
+            std::chrono::nanoseconds ns{};
+            switch (node.kind) {
+                case HCValue::ScalarKind::Bool: value.tryBool(b); node.bits = b; break;
+                case HCValue::ScalarKind::Int: value.tryInt64(i); std::memcpy(&node.bits, &i, sizeof(i)); break;
+                case HCValue::ScalarKind::Double: value.tryDouble(d); std::memcpy(&node.bits, &d, sizeof(d)); break;
+                case HCValue::ScalarKind::Duration:
+                    value.tryDuration(ns);
+                    i = ns.count();
+                    std::memcpy(&node.bits, &i, sizeof(i));
+                    break;
+                case HCValue::ScalarKind::Bytes: value.tryBytes(node.bits); break;
+                default: break;
+            }
+            return append(&node, 1);
+        }
+
+        std::uint32_t value(const HCValue& v) {
+            if (v.isMap()) return map(v.asMap());
+            if (v.isList()) return list(v.asList());
+            if (std::holds_alternative<std::monostate>(v.value)) {
+                HCSnapshotNode node{};
+                return append(&node, 1);
+            }
+            return scalar(v);
+        }
+
+        std::uint32_t list(const HCList& items) {
+            std::vector<std::uint32_t> nodes;
+            nodes.reserve(items.size());
+            for (const auto& item : items) nodes.push_back(value(item));
+
+            HCSnapshotNode node{};
+            node.type = HCSnapshotNode::Type::List;
+            node.count = static_cast<std::uint32_t>(nodes.size());
+            node.offset = append(nodes.data(), nodes.size());
+            return append(&node, 1);
+        }
+
+        // entry table in file order, followed by the entry indices sorted by lowercased key
+        std::uint32_t map(const HCMap& m) {
+            std::vector<HCSnapshotEntry> entries;
+            entries.reserve(m.size());
+            for (const auto& [key, child] : m) {
+                std::uint32_t node = value(child);
+                entries.push_back({text(key), static_cast<std::uint32_t>(key.size()), node});
+            }
+
+            std::vector<std::uint32_t> order(m.size());
+            for (std::uint32_t i = 0; i < order.size(); ++i) order[i] = i;
+            std::stable_sort(order.begin(), order.end(), [&](std::uint32_t a, std::uint32_t b) {
+                return compareKeys(m[a].first, m[b].first) < 0;
+            });
+
+            HCSnapshotNode node{};
+            node.type = HCSnapshotNode::Type::Map;
+            node.count = static_cast<std::uint32_t>(entries.size());
+            node.offset = append(entries.data(), entries.size());
+            append(order.data(), order.size());
+            return append(&node, 1);
+        }
+
+    };
+
+    // one node of a mapped snapshot. cheap to copy, valid as long as the buffer is
+    class HCSnapshotValue {
+    public:
+        HCSnapshotValue() = default;
+        HCSnapshotValue(const char* base, const HCSnapshotNode* node) : base_(base), node_(node) {}
+
+        explicit operator bool() const { return node_ != nullptr; }
+        bool isMap() const { return node_ && node_->type == HCSnapshotNode::Type::Map; }
+        bool isList() const { return node_ && node_->type == HCSnapshotNode::Type::List; }
+        bool isScalar() const { return node_ && node_->type == HCSnapshotNode::Type::Scalar; }
+        size_t size() const { return isMap() || isList() ? node_->count : 0; }
+
+        HCValue::ScalarKind scalarKind() const { return isScalar() ? node_->kind : HCValue::ScalarKind::None; }
+
+        // the scalar's text, as HCValue::asString gives it
+        std::string_view text() const {
+            if (!isScalar()) return {};
+            return std::string_view(base_ + node_->offset, node_->length);
+        }
+
+        // map key / value or list item at position i, in file order
+        std::string_view key(size_t i) const {
+            if (!isMap() || i >= node_->count) return {};
+            const auto& entry = entries()[i];
+            return std::string_view(base_ + entry.key, entry.keyLength);
+        }
+        HCSnapshotValue at(size_t i) const {
+            if (isMap() && i < node_->count) return child(entries()[i].node);
+            if (isList() && i < node_->count) return child(reinterpret_cast<const std::uint32_t*>(base_ + node_->offset)[i]);
+            return {};
+        }
+
+        // case-insensitive like every HotConfig lookup, binary search over the sorted index
+        HCSnapshotValue find(std::string_view key) const {
+            if (!isMap()) return {};
+            const HCSnapshotEntry* table = entries();
+            const std::uint32_t* order = reinterpret_cast<const std::uint32_t*>(table + node_->count);
+            size_t lo = 0, hi = node_->count;
+            while (lo < hi) {
+                size_t mid = (lo + hi) / 2;
+                const auto& entry = table[order[mid]];
+                if (HCSnapshotWriter::compareKeys(std::string_view(base_ + entry.key, entry.keyLength), key) < 0) lo = mid + 1;
+                else hi = mid;
+            }
+            if (lo == node_->count) return {};
+            const auto& entry = table[order[lo]];
+            if (HCSnapshotWriter::compareKeys(std::string_view(base_ + entry.key, entry.keyLength), key) != 0) return {};
+            return child(entry.node);
+        }
+
+        // dotted path, as HotConfig::get
+        HCSnapshotValue get(std::string_view keyPath) const {
+            HCSnapshotValue current = *this;
+            size_t pos = 0;
+            while (current) {
+                size_t dot = keyPath.find('.', pos);
+                current = current.find(keyPath.substr(pos, dot == std::string_view::npos ? dot : dot - pos));
+                if (dot == std::string_view::npos) break;
+                pos = dot + 1;
+            }
+            return current;
+        }
+
+        // same conversions as the HCValue typed reads
+        bool tryBool(bool& out) const {
+            if (scalarKind() == HCValue::ScalarKind::Bool) {
+                out = node_->bits != 0;
+                return true;
+            }
+            return scalarKind() == HCValue::ScalarKind::String && parseBool(trimView(text()), out);
+        }
+
+        bool tryInt64(std::int64_t& out) const {
+            if (scalarKind() == HCValue::ScalarKind::Int) {
+                std::memcpy(&out, &node_->bits, sizeof(out));
+                return true;
+            }
+            return scalarKind() == HCValue::ScalarKind::String && parseInt64(trimView(text()), out);
+        }
+
+        bool tryDouble(double& out) const {
+            if (scalarKind() == HCValue::ScalarKind::Double) {
+                std::memcpy(&out, &node_->bits, sizeof(out));
+                return true;
+            }
+            std::int64_t i = 0;
+            if (scalarKind() == HCValue::ScalarKind::Int && tryInt64(i)) {
+                out = static_cast<double>(i);
+                return true;
+            }
+            return scalarKind() == HCValue::ScalarKind::String && parseDouble(trimView(text()), out);
+        }
+
+        bool tryDuration(std::chrono::nanoseconds& out) const {
+            std::int64_t ns = 0;
+            if (scalarKind() == HCValue::ScalarKind::Duration) std::memcpy(&ns, &node_->bits, sizeof(ns));
+            else if (scalarKind() != HCValue::ScalarKind::String || !parseDurationText(trimView(text()), ns)) return false;
+            out = std::chrono::nanoseconds(ns);
+            return true;
+        }
+
+        bool tryBytes(std::uint64_t& out) const {
+            std::int64_t i = 0;
+            if (scalarKind() == HCValue::ScalarKind::Bytes) {
+                out = node_->bits;
+                return true;
+            }
+            if (scalarKind() == HCValue::ScalarKind::Int && tryInt64(i)) {
+                if (i < 0) return false;
+                out = static_cast<std::uint64_t>(i);
+                return true;
+            }
+            return scalarKind() == HCValue::ScalarKind::String && parseByteSize(trimView(text()), out);
+        }
+
+        // a regular (heap) copy of this node
+        HCValue toValue() const {
+            if (isMap()) {
+                HCMap map;
+                map.reserve(size());
+                for (size_t i = 0; i < size(); ++i) map.emplace_back(std::string(key(i)), at(i).toValue());
+                return HCValue(std::move(map));
+            }
+            if (isList()) {
+                HCList list;
+                list.reserve(size());
+                for (size_t i = 0; i < size(); ++i) list.push_back(at(i).toValue());
+                return HCValue(std::move(list));
+            }
+            if (!isScalar()) return HCValue();
+            if (node_->native) {
+                bool b = false;
+                std::int64_t i = 0;
+                double d = 0.0;
+                if (tryBool(b)) return HCValue(b);
+                if (tryInt64(i)) return HCValue(static_cast<int>(i));
+                if (tryDouble(d)) return HCValue(d);
+            }
+            if (node_->kind == HCValue::ScalarKind::String) return HCValue(std::string(text()));
+            return HCValue::Raw(std::string(text()));
+        }
+
+    private:
+        const char* base_ = nullptr;
+        const HCSnapshotNode* node_ = nullptr;
+
+        const HCSnapshotEntry* entries() const { return reinterpret_cast<const HCSnapshotEntry*>(base_ + node_->offset); }
+        HCSnapshotValue child(std::uint32_t offset) const {
+            return HCSnapshotValue(base_, reinterpret_cast<const HCSnapshotNode*>(base_ + offset));
+        }
+    };
+
+    // a snapshot buffer, not owned. Open checks the header and the size only: the offsets inside
+    // are trusted, snapshots are meant to come from HCSnapshotWriter on the same host
+    class HCSnapshotView {
+    public:
+        HCSnapshotView() = default;
+
+        bool Open(const void* data, size_t size) {
+            header_ = nullptr;
+            if (!data || size < sizeof(HCSnapshotHeader) || reinterpret_cast<std::uintptr_t>(data) % alignof(HCSnapshotHeader)) return false;
+            auto header = static_cast<const HCSnapshotHeader*>(data);
+            if (std::memcmp(header->magic, HCSnapshotHeader::Magic, sizeof(header->magic)) != 0) return false;
+            if (header->layout != HCSnapshotHeader::Layout || header->size > size) return false;
+            if (header->root + sizeof(HCSnapshotNode) > header->size) return false;
+            header_ = header;
+            return true;
+        }
+
+        bool Valid() const { return header_ != nullptr; }
+        std::uint64_t Version() const { return header_ ? header_->version : 0; }
+        std::uint64_t Generation() const { return header_ ? header_->generation : 0; }
+        // HCValue::hash of the root the snapshot was written from
+        std::uint64_t Hash() const { return header_ ? header_->hash : 0; }
+        size_t Size() const { return header_ ? header_->size : 0; }
+
+        HCSnapshotValue Root() const {
+            if (!header_) return {};
+            auto base = reinterpret_cast<const char*>(header_);
+            return HCSnapshotValue(base, reinterpret_cast<const HCSnapshotNode*>(base + header_->root));
+        }
+
+        HCSnapshotValue Get(std::string_view keyPath) const { return Root().get(keyPath); }
+
+        HCMap ToMap() const {
+            HCValue root = Root().toValue();
+            return root.isMap() ? std::move(root.asMap()) : HCMap{};
+        }
+
+    private:
+        const HCSnapshotHeader* header_ = nullptr;
+    };
+
+#ifndef _WIN32
+    namespace SharedDetail {
+        struct Control {
+            static constexpr char Magic[8] = {'H', 'C', 'S', 'H', 'M', '\0', '\0', '\0'};
+            char magic[8];
+            std::atomic<std::uint64_t> generation;
+        };
+        static_assert(std::atomic<std::uint64_t>::is_always_lock_free, "shared generation counter must be lock-free");
+
+        // POSIX shm names are "/name" without any further slash
+        inline std::string segmentName(const std::string& name) {
+            std::string out = name.empty() || name[0] != '/' ? "/" + name : name;
+            std::replace(out.begin() + 1, out.end(), '/', '_');
+            return out;
+        }
+
+        inline std::string dataName(const std::string& control, std::uint64_t generation) {
+            return control + "." + std::to_string(generation);
+        }
+
+        // maps the control segment, creating it when `create` (readers map it read-only). nullptr on failure
+        inline Control* mapControl(const std::string& name, bool create, mode_t mode) {
+            int fd = shm_open(name.c_str(), create ? O_RDWR | O_CREAT : O_RDONLY, mode);
+            if (fd < 0) return nullptr;
+            struct stat st {};
+            if (fstat(fd, &st) != 0 || (st.st_size < static_cast<off_t>(sizeof(Control)) && (!create || ftruncate(fd, sizeof(Control)) != 0))) {
+                close(fd);
+                return nullptr;
+            }
+            void* p = mmap(nullptr, sizeof(Control), create ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, fd, 0);
+            close(fd);
+            if (p == MAP_FAILED) return nullptr;
+
+            auto control = static_cast<Control*>(p);
+            // a fresh segment is zero-filled, which is generation 0 with no magic yet
+            if (create && std::memcmp(control->magic, Control::Magic, sizeof(control->magic)) != 0) {
+                std::memcpy(control->magic, Control::Magic, sizeof(control->magic));
+            }
+            if (std::memcmp(control->magic, Control::Magic, sizeof(control->magic)) != 0) {
+                munmap(p, sizeof(Control));
+                return nullptr;
+            }
+            return control;
+        }
+    }
+
+    // a published snapshot mapped into this process
+    class HCSharedSnapshot {
+    public:
+        HCSharedSnapshot(const HCSharedSnapshot&) = delete;
+        HCSharedSnapshot& operator=(const HCSharedSnapshot&) = delete;
+        ~HCSharedSnapshot() { munmap(data_, size_); }
+
+        const HCSnapshotView& View() const { return view_; }
+        std::uint64_t Generation() const { return view_.Generation(); }
+        std::uint64_t Version() const { return view_.Version(); }
+        HCSnapshotValue Get(std::string_view keyPath) const { return view_.Get(keyPath); }
+
+        // nullptr if the segment is gone (already replaced and unlinked) or isn't a snapshot
+        static std::shared_ptr<const HCSharedSnapshot> Map(const std::string& segment, std::uint64_t generation) {
+            int fd = shm_open(segment.c_str(), O_RDONLY, 0);
+            if (fd < 0) return nullptr;
+            struct stat st {};
+            if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+                close(fd);
+                return nullptr;
+            }
+            void* p = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_SHARED, fd, 0);
+            close(fd);
+            if (p == MAP_FAILED) return nullptr;
+            std::shared_ptr<HCSharedSnapshot> snapshot(new HCSharedSnapshot(p, static_cast<size_t>(st.st_size)));
+            if (!snapshot->view_.Open(p, snapshot->size_) || snapshot->view_.Generation() != generation) return nullptr;
+            return snapshot;
+        }
+
+    private:
+        HCSharedSnapshot(void* data, size_t size) : data_(data), size_(size) {}
+
+        void* data_;
+        size_t size_;
+        HCSnapshotView view_;
+    };
+
+    // the writing side, one per name. segments outlive the publisher, so a restarted publisher
+    // carries on with the next generation and attached readers follow it; Unlink removes them.
+    class HCSharedPublisher {
+    public:
+        explicit HCSharedPublisher(const std::string& name, mode_t mode = 0600)
+            : name_(SharedDetail::segmentName(name)), mode_(mode) {
+            control_ = SharedDetail::mapControl(name_, true, mode_);
+        }
+
+        HCSharedPublisher(const HCSharedPublisher&) = delete;
+        HCSharedPublisher& operator=(const HCSharedPublisher&) = delete;
+        ~HCSharedPublisher() {
+            if (control_) munmap(control_, sizeof(SharedDetail::Control));
+        }
+
+        bool Ready() const { return control_ != nullptr; }
+        const std::string& Name() const { return name_; }
+        std::uint64_t Generation() const { return control_ ? control_->generation.load(std::memory_order_acquire) : 0; }
+
+        // writes the tree as the next generation and switches readers to it. the previous
+        // generation's segment is unlinked, readers that have it mapped keep it until they drop it.
+        // returns the new generation, 0 on failure (nothing changes then)
+        std::uint64_t Publish(const HCMap& root, std::uint64_t version = 0) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!control_) return 0;
+            std::uint64_t previous = control_->generation.load(std::memory_order_acquire);
+            std::uint64_t generation = previous + 1;
+            std::string bytes = HCSnapshotWriter::Write(root, version, generation);
+
+            std::string segment = SharedDetail::dataName(name_, generation);
+            int fd = shm_open(segment.c_str(), O_RDWR | O_CREAT | O_TRUNC, mode_);
+            if (fd < 0) return 0;
+            bool ok = ftruncate(fd, static_cast<off_t>(bytes.size())) == 0;
+            for (size_t done = 0; ok && done < bytes.size();) {
+                ssize_t n = pwrite(fd, bytes.data() + done, bytes.size() - done, static_cast<off_t>(done));
+                if (n < 0 && errno == EINTR) continue;
+                ok = n > 0;
+                if (ok) done += static_cast<size_t>(n);
+            }
+            close(fd);
+            if (!ok) {
+                shm_unlink(segment.c_str());
+                return 0;
+            }
+
+            control_->generation.store(generation, std::memory_order_release);
+            if (previous) shm_unlink(SharedDetail::dataName(name_, previous).c_str());
+            return generation;
+        }
+
+        // removes the control segment and the current snapshot. mappings stay valid
+        void Unlink() {
+            std::lock_guard<std::mutex> lock(mutex_);
+            std::uint64_t generation = Generation();
+            if (generation) shm_unlink(SharedDetail::dataName(name_, generation).c_str());
+            shm_unlink(name_.c_str());
+        }
+
+    private:
+        std::string name_;
+        mode_t mode_;
+        SharedDetail::Control* control_ = nullptr;
+        std::mutex mutex_;
+    };
+
+    // the reading side. Current() costs one atomic load while the generation is unchanged
+    class HCSharedReader {
+    public:
+        explicit HCSharedReader(const std::string& name) : name_(SharedDetail::segmentName(name)) {}
+
+        HCSharedReader(const HCSharedReader&) = delete;
+        HCSharedReader& operator=(const HCSharedReader&) = delete;
+        ~HCSharedReader() {
+            if (control_) munmap(control_, sizeof(SharedDetail::Control));
+        }
+
+        // false until a publisher created the segment
+        bool Attach() {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!control_) control_ = SharedDetail::mapControl(name_, false, 0);
+            return control_ != nullptr;
+        }
+
+        // generation the publisher is at, 0 if nothing was published (or not attached)
+        std::uint64_t Generation() const { return control_ ? control_->generation.load(std::memory_order_acquire) : 0; }
+
+        // the newest snapshot, mapped on first use of each generation. nullptr if there is none.
+        // a publish racing with this can unlink the generation just read, then the next one is taken
+        std::shared_ptr<const HCSharedSnapshot> Current() {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!control_) return nullptr;
+            for (int attempt = 0; attempt < 8; ++attempt) {
+                std::uint64_t generation = control_->generation.load(std::memory_order_acquire);
+                if (!generation) return nullptr;
+                if (current_ && current_->Generation() == generation) return current_;
+                if (auto snapshot = HCSharedSnapshot::Map(SharedDetail::dataName(name_, generation), generation)) {
+                    current_ = std::move(snapshot);
+                    return current_;
+                }
+            }
+            return current_;
+        }
+
+    private:
+        std::string name_;
+        SharedDetail::Control* control_ = nullptr;
+        std::shared_ptr<const HCSharedSnapshot> current_;
+        std::mutex mutex_;
+    };
+#endif
+}
@@ -1,13 +1,27 @@
 #pragma once
 
+#include <cstddef>
 #include <filesystem>
 #include <fstream>
 #include <optional>
 #include <string>
 #include <string_view>
 #include <system_error>
+#include <utility>
 #include <vector>
 
+#if __cplusplus >= 202002L
+#include <span>
+#endif
+
+#ifndef _WIN32
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 namespace fs = std::filesystem;
 
 namespace MF::FilesManager {    
@@ -90,13 +104,55 @@ namespace MF::FilesManager {
         return std::nullopt;
     }
 
-    // read entire file into string
+    // read entire file into string: one allocation of the size fstat reports, then read() until
+    // end of file (files that report no size, like /proc entries, grow as they are read)
     inline std::optional<std::string> ReadFileToString(const std::string& Path) noexcept {
         try {
-            std::ifstream File(fs::u8path(Path), std::ios::binary);
+#ifndef _WIN32
+            int Fd = ::open(fs::u8path(Path).c_str(), O_RDONLY | O_CLOEXEC);
+            if (Fd < 0) return std::nullopt;
+            struct stat St {};
+            if (fstat(Fd, &St) != 0 || S_ISDIR(St.st_mode)) {
+                ::close(Fd);
+                return std::nullopt;
+            }
+            std::string Content;
+            Content.resize(St.st_size > 0 ? static_cast<size_t>(St.st_size) : 4096);
+            size_t Used = 0;
+            while (true) {
+                if (Used == Content.size()) Content.resize(Content.size() * 2);
+                ssize_t Got = ::read(Fd, Content.data() + Used, Content.size() - Used);
+                if (Got < 0 && errno == EINTR) continue;
+                if (Got < 0) {
+                    ::close(Fd);
+                    return std::nullopt;
+                }
+                if (Got == 0) break;
+                Used += static_cast<size_t>(Got);
+                // all fstat promised is in: a one-byte read confirms the end without growing the buffer
+                if (Used == static_cast<size_t>(St.st_size) && St.st_size > 0) {
+                    char Probe;
+                    ssize_t More = ::read(Fd, &Probe, 1);
+                    while (More < 0 && errno == EINTR) More = ::read(Fd, &Probe, 1);
+                    if (More <= 0) break;
+                    Content.resize(Content.size() * 2);
+                    Content[Used++] = Probe;
+                }
+            }
+            ::close(Fd);
+            Content.resize(Used);
+            return Content;
+#else
+            std::ifstream File(fs::u8path(Path), std::ios::binary | std::ios::ate);
             if (!File.is_open()) return std::nullopt;
-            std::string Content((std::istreambuf_iterator<char>(File)), std::istreambuf_iterator<char>());
+            std::streamoff Size = File.tellg();
+            if (Size < 0) return std::nullopt;
+            std::string Content(static_cast<size_t>(Size), '\0');
+            File.seekg(0);
+            File.read(Content.data(), Size);
+            Content.resize(static_cast<size_t>(File.gcount()));
             return Content;
+#endif
         } catch (...) {
             return std::nullopt;
         }
@@ -162,4 +218,163 @@ namespace MF::FilesManager {
         std::ofstream File(fs::u8path(Path), std::ios::app);
         return File.good();
     }
+
+#ifndef _WIN32
+    // a file mapped into memory, unmapped when the object goes away.
+    //   FilesManager::MappedFile File;
+    //   FilesManager::MappedFile::Options Opts;
+    //   Opts.Advice = FilesManager::MappedFile::Access::Sequential;
+    //   if (auto Err = File.Open(Path, Opts)) ...
+    //   std::string_view Text = File.View();
+    // read-only maps are private: the pages come from the page cache without a copy, but a file
+    // truncated by someone else while mapped faults (SIGBUS) on the missing pages, and changes
+    // written to it may or may not show. ReadWrite maps are shared, writes go to the file.
+    class MappedFile {
+    public:
+        enum class Mode { ReadOnly, ReadWrite };
+        enum class Access { Normal, Sequential, Random, WillNeed, DontNeed };
+
+        struct Options {
+            Mode OpenMode = Mode::ReadOnly;
+            Access Advice = Access::Normal;
+            bool Populate = false;     // fault every page in up front (MAP_POPULATE)
+            bool HugePages = false;    // ask for transparent huge pages, where the file system has them
+            size_t Size = 0;           // ReadWrite: create the file or resize it to this many bytes first
+        };
+
+        MappedFile() = default;
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+        MappedFile(MappedFile&& Other) noexcept { swap(Other); }
+        MappedFile& operator=(MappedFile&& Other) noexcept {
+            if (this != &Other) {
+                Close();
+                swap(Other);
+            }
+            return *this;
+        }
+        ~MappedFile() { Close(); }
+
+        // nullopt on success, the error otherwise. an empty file opens with no mapping and Size() 0
+        std::optional<std::string> Open(const std::string& Path) noexcept { return Open(Path, Options{}); }
+        std::optional<std::string> Open(const std::string& Path, const Options& Opts) noexcept {
+            try {
+                return openFile(Path, Opts);
+            } catch (const std::exception& e) {
+                Close();
+                return e.what();
+            }
+        }
+
+        // a hint for [Offset, Offset + Length) (the whole file by default); false if the kernel
+        // refused it
+        bool Advise(Access Advice, size_t Offset = 0, size_t Length = std::string_view::npos) noexcept {
+            if (!Data_ || Offset >= Size_) return false;
+            // madvise wants a page-aligned start
+            size_t Page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+            size_t Start = Offset / Page * Page;
+            size_t End = Length >= Size_ - Offset ? Size_ : Offset + Length;
+            int Hint = MADV_NORMAL;
+            switch (Advice) {
+                case Access::Sequential: Hint = MADV_SEQUENTIAL; break;
+                case Access::Random:     Hint = MADV_RANDOM; break;
+                case Access::WillNeed:   Hint = MADV_WILLNEED; break;
+                case Access::DontNeed:   Hint = MADV_DONTNEED; break;
+                default: break;
+            }
+            return madvise(Data_ + Start, End - Start, Hint) == 0;
+        }
+
+        // ReadWrite: writes the dirty pages back (Async only schedules it)
+        std::optional<std::string> Sync(bool Async = false) noexcept {
+            if (!Data_ || !Writable_) return std::nullopt;
+            if (msync(Data_, Size_, Async ? MS_ASYNC : MS_SYNC) != 0) return "msync: " + std::error_code(errno, std::generic_category()).message();
+            return std::nullopt;
+        }
+
+        void Close() noexcept {
+            if (Data_) munmap(Data_, Size_);
+            Data_ = nullptr;
+            Size_ = 0;
+            Writable_ = false;
+            Open_ = false;
+        }
+
+        bool IsOpen() const noexcept { return Open_; }
+        bool Writable() const noexcept { return Writable_; }
+        size_t Size() const noexcept { return Size_; }
+        const char* Data() const noexcept { return Data_; }
+        // nullptr unless mapped ReadWrite
+        char* MutableData() noexcept { return Writable_ ? Data_ : nullptr; }
+
+        std::string_view View() const noexcept { return Data_ ? std::string_view(Data_, Size_) : std::string_view(); }
+#ifdef __cpp_lib_span
+        // C++20 builds only
+        std::span<const std::byte> Bytes() const noexcept { return {reinterpret_cast<const std::byte*>(Data_), Data_ ? Size_ : 0}; }
+        std::span<std::byte> MutableBytes() noexcept { return {reinterpret_cast<std::byte*>(MutableData()), Writable_ ? Size_ : 0}; }
+#endif
+
+    private:
+        char* Data_ = nullptr;
+        size_t Size_ = 0;
+        bool Writable_ = false;
+        bool Open_ = false;
+
+        // Open without the catch; the descriptor is closed before anything that can throw
+        std::optional<std::string> openFile(const std::string& Path, const Options& Opts) {
+            Close();
+            bool Writable = Opts.OpenMode == Mode::ReadWrite;
+            int Flags = (Writable ? O_RDWR : O_RDONLY) | O_CLOEXEC;
+            if (Writable && Opts.Size) Flags |= O_CREAT;
+            int Fd = ::open(fs::u8path(Path).c_str(), Flags, 0644);
+            if (Fd < 0) return error("open", Path);
+            struct stat St {};
+            if (fstat(Fd, &St) != 0) return error("fstat", Path, Fd);
+            if (!S_ISREG(St.st_mode)) {
+                ::close(Fd);
+                return "Not a regular file: " + Path;
+            }
+            size_t Length = static_cast<size_t>(St.st_size);
+            if (Writable && Opts.Size && Opts.Size != Length) {
+                if (ftruncate(Fd, static_cast<off_t>(Opts.Size)) != 0) return error("ftruncate", Path, Fd);
+                Length = Opts.Size;
+            }
+            if (Length) {
+                int MapFlags = Writable ? MAP_SHARED : MAP_PRIVATE;
+#ifdef MAP_POPULATE
+                if (Opts.Populate) MapFlags |= MAP_POPULATE;
+#endif
+                void* P = mmap(nullptr, Length, Writable ? PROT_READ | PROT_WRITE : PROT_READ, MapFlags, Fd, 0);
+                if (P == MAP_FAILED) return error("mmap", Path, Fd);
+                Data_ = static_cast<char*>(P);
+            }
+            // the mapping keeps the file referenced, the descriptor isn't needed any more
+            ::close(Fd);
+            Size_ = Length;
+            Writable_ = Writable;
+            Open_ = true;
+#ifdef MADV_HUGEPAGE
+            if (Opts.HugePages && Data_) madvise(Data_, Size_, MADV_HUGEPAGE);
+#endif
+            if (Opts.Advice != Access::Normal) Advise(Opts.Advice);
+#ifndef MAP_POPULATE
+            if (Opts.Populate) Advise(Access::WillNeed);
+#endif
+            return std::nullopt;
+        }
+
+        void swap(MappedFile& Other) noexcept {
+            std::swap(Data_, Other.Data_);
+            std::swap(Size_, Other.Size_);
+            std::swap(Writable_, Other.Writable_);
+            std::swap(Open_, Other.Open_);
+        }
+
+        static std::string error(const char* Call, const std::string& Path, int Fd = -1) {
+            std::error_code Ec(errno, std::generic_category());
+            if (Fd >= 0) ::close(Fd);
+            return std::string(Call) + " failed for " + Path + ": " + Ec.message();
+        }
+    };
+#endif
 }
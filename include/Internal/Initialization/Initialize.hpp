@@ -7,6 +7,7 @@
 #include "../../Outer/Info/MFWork.h"
 #include "../Global/GlobalDefinitions.hpp"
 #include "../Time&Date/Misc.hpp"
+#include "../Profiling/Profiler.hpp"
 #include "../Utils/CoreUtilities.hpp"
 #include <variant>
 #include <vector>
@@ -71,91 +72,105 @@ namespace MF::Initializer {
             }, v);
             MF::Print::Out(MF::Print::LogLevel::Debug, "Applied override \"" + key + "\" -> " + (target ? "true" : "false"));
         }
-    }
 
-    inline bool InitializeMFWork(int argc, char* argv[]) {
-        Time::Timer timer("ms");
-        if (Global::GlobalSettings.Init.StartTimer) {
-            timer.start();
-        }
+        inline bool Initialize(int argc, char* argv[]) {
+            MF_PROFILE_SCOPE("InitializeMFWork");
+            Time::Timer timer("ms");
+            if (Global::GlobalSettings.Init.StartTimer) {
+                timer.start();
+            }
 
-        if (!Global::GlobalSettings.Usable) {
-            MF::Print::Out(MF::Print::LogLevel::Error, "MFWork could not be initialized: InternalSettings not setup!");
-            return false;
-        }
+            if (!Global::GlobalSettings.Usable) {
+                MF::Print::Out(MF::Print::LogLevel::Error, "MFWork could not be initialized: InternalSettings not setup!");
+                return false;
+            }
 
-        if (Global::GlobalSettings.Init.ParseArguments) {
-            MF::Print::Out(MF::Print::LogLevel::Debug, "Parsing arguments...");
-            MF::Global::ArgumentParser.Parse(argc, argv);
+            if (Global::GlobalSettings.Init.ParseArguments) {
+                MF_PROFILE_SCOPE("ParseArguments");
+                MF::Print::Out(MF::Print::LogLevel::Debug, "Parsing arguments...");
+                MF::Global::ArgumentParser.Parse(argc, argv);
 
-            bool RuntimeHasArguments = !Global::ArgumentParser.Dump().empty() && !MF::Global::ArgumentParser.Positional().empty();
+                bool RuntimeHasArguments = !Global::ArgumentParser.Dump().empty() && !MF::Global::ArgumentParser.Positional().empty();
 
-            if (RuntimeHasArguments) {
-                MF::Print::Out(MF::Print::LogLevel::Debug, "No arguments found.");
-            }
-            bool TalkedAboutNoArguments = false;
-            if (Global::GlobalSettings.Init.AllowOverrides && RuntimeHasArguments) {
-                Internal::applyBoolOverride("checkCriticalFiles", Global::GlobalSettings.Init.CheckCriticalFiles, true);
-                Internal::applyBoolOverride("autoDetermineLogLevel", Global::GlobalSettings.Init.AutoDetermineLogLevel, true);
-                Internal::applyBoolOverride("validateSession", Global::GlobalSettings.Init.ValidateSession, true);
-                Internal::applyBoolOverride("logBuildChannel", Global::GlobalSettings.Init.LogBuildChannel, true);
-                Internal::applyBoolOverride("alertOnUnstableChannel", Global::GlobalSettings.Init.AlertOnUnstableChannel, true);
-            } else if (!Global::GlobalSettings.Init.AllowOverrides) {
-                Print::Out(Print::LogLevel::Debug, "Skipping implementing overrides, overrides are prohibited...");
-                TalkedAboutNoArguments = true;
-            } else if (!RuntimeHasArguments && !TalkedAboutNoArguments) {
-                Print::Out(Print::LogLevel::Debug, "Skipping implementing overrides, app was launched with no arguments...");
+                if (RuntimeHasArguments) {
+                    MF::Print::Out(MF::Print::LogLevel::Debug, "No arguments found.");
+                }
+                bool TalkedAboutNoArguments = false;
+                if (Global::GlobalSettings.Init.AllowOverrides && RuntimeHasArguments) {
+                    Internal::applyBoolOverride("checkCriticalFiles", Global::GlobalSettings.Init.CheckCriticalFiles, true);
+                    Internal::applyBoolOverride("autoDetermineLogLevel", Global::GlobalSettings.Init.AutoDetermineLogLevel, true);
+                    Internal::applyBoolOverride("validateSession", Global::GlobalSettings.Init.ValidateSession, true);
+                    Internal::applyBoolOverride("logBuildChannel", Global::GlobalSettings.Init.LogBuildChannel, true);
+                    Internal::applyBoolOverride("alertOnUnstableChannel", Global::GlobalSettings.Init.AlertOnUnstableChannel, true);
+                    Internal::applyBoolOverride("profile", Global::GlobalSettings.Init.Profile, true);
+                    if (Global::GlobalSettings.Init.Profile) Profiling::Enable();
+                } else if (!Global::GlobalSettings.Init.AllowOverrides) {
+                    Print::Out(Print::LogLevel::Debug, "Skipping implementing overrides, overrides are prohibited...");
+                    TalkedAboutNoArguments = true;
+                } else if (!RuntimeHasArguments && !TalkedAboutNoArguments) {
+                    Print::Out(Print::LogLevel::Debug, "Skipping implementing overrides, app was launched with no arguments...");
+                }
             }
-        }
 
-        if (Global::GlobalSettings.Init.CheckCriticalFiles) {
-            std::vector<std::string> CriticalFiles = Global::GlobalSettings.Init.CriticalFiles;
-            for (const auto& file : CriticalFiles) {
-                if (!MF::FilesManager::Exists(file)) {
-                    MF::Print::Out(MF::Print::LogLevel::Error, "Critical file \"" + file + "\" not found!");
-                    return false;
+            if (Global::GlobalSettings.Init.CheckCriticalFiles) {
+                MF_PROFILE_SCOPE("CheckCriticalFiles");
+                std::vector<std::string> CriticalFiles = Global::GlobalSettings.Init.CriticalFiles;
+                for (const auto& file : CriticalFiles) {
+                    if (!MF::FilesManager::Exists(file)) {
+                        MF::Print::Out(MF::Print::LogLevel::Error, "Critical file \"" + file + "\" not found!");
+                        return false;
+                    }
                 }
             }
-        }
 
-        if (Global::GlobalSettings.Init.AutoDetermineLogLevel) {
-            if (MF::Internal::Utils::CoreUtilities::NormalizeString(Global::GlobalSettings.Project.Build.Channel) != "production") {
-                Global::GlobalSettings.Print.CurrentLevel = Print::LogLevel::Debug;
+            if (Global::GlobalSettings.Init.AutoDetermineLogLevel) {
+                if (MF::Internal::Utils::CoreUtilities::NormalizeString(Global::GlobalSettings.Project.Build.Channel) != "production") {
+                    Global::GlobalSettings.Print.CurrentLevel = Print::LogLevel::Debug;
+                }
             }
-        }
 
-        if (Global::GlobalSettings.Init.ValidateSession) {
-            MF::Runtime::Session::Validate(true);
-        }
+            if (Global::GlobalSettings.Init.ValidateSession) {
+                MF_PROFILE_SCOPE("ValidateSession");
+                MF::Runtime::Session::Validate(true);
+            }
 
-        if (Global::GlobalSettings.Init.LogBuildChannel) {
-            try {
-                std::string BuildChannel = Global::GlobalSettings.Project.Build.Channel;
-                if (!BuildChannel.empty()) {
-                    std::string ch = MF::Internal::Utils::CoreUtilities::NormalizeString(BuildChannel);
-                    ch = MF::Internal::Utils::CoreUtilities::Capitalize(ch);
-                    MF::Print::Out(MF::Print::LogLevel::Debug, "Running on " + ch + " channel.");
+            if (Global::GlobalSettings.Init.LogBuildChannel) {
+                MF_PROFILE_SCOPE("LogBuildChannel");
+                try {
+                    std::string BuildChannel = Global::GlobalSettings.Project.Build.Channel;
+                    if (!BuildChannel.empty()) {
+                        std::string ch = MF::Internal::Utils::CoreUtilities::NormalizeString(BuildChannel);
+                        ch = MF::Internal::Utils::CoreUtilities::Capitalize(ch);
+                        MF::Print::Out(MF::Print::LogLevel::Debug, "Running on " + ch + " channel.");
+                    }
+                } catch (std::exception& e) {
+                    MF::Print::Out(MF::Print::LogLevel::Error, "Failed to get build channel: " + std::string(e.what()));
+                    return false;
                 }
-            } catch (std::exception& e) {
-                MF::Print::Out(MF::Print::LogLevel::Error, "Failed to get build channel: " + std::string(e.what()));
-                return false;
             }
-        }
 
-        MF::Global::Initialized = true;
-        MF::Print::Out(MF::Print::LogLevel::Debug, "Assigned MF::Global::Initialized to true.");
-        if (Global::GlobalSettings.Init.StartTimer) {
-            timer.stop();
-            MF::Print::Out(MF::Print::LogLevel::Debug, "Initialization complete in " + timer.elapsedString());
-        }
-        else {
-            MF::Print::Out(MF::Print::LogLevel::Debug, "Initialization complete.");
-        }
+            MF::Global::Initialized = true;
+            MF::Print::Out(MF::Print::LogLevel::Debug, "Assigned MF::Global::Initialized to true.");
+            if (Global::GlobalSettings.Init.StartTimer) {
+                timer.stop();
+                MF::Print::Out(MF::Print::LogLevel::Debug, "Initialization complete in " + timer.elapsedString());
+            }
+            else {
+                MF::Print::Out(MF::Print::LogLevel::Debug, "Initialization complete.");
+            }
 
-        if (MF::Internal::Utils::CoreUtilities::NormalizeString(BuildInfo::Channel) != "production" && Global::GlobalSettings.Init.AlertOnUnstableChannel) {
-            MF::Print::Out(MF::Print::LogLevel::Warning, "MFWork is running on an unstable build (" + BuildInfo::Channel + ").");
-            MF::Print::Out(MF::Print::LogLevel::Warning, "Please report any issues to \"" + BuildInfo::GithubRepo + "issues/\".");
+            if (MF::Internal::Utils::CoreUtilities::NormalizeString(BuildInfo::Channel) != "production" && Global::GlobalSettings.Init.AlertOnUnstableChannel) {
+                MF::Print::Out(MF::Print::LogLevel::Warning, "MFWork is running on an unstable build (" + BuildInfo::Channel + ").");
+                MF::Print::Out(MF::Print::LogLevel::Warning, "Please report any issues to \"" + BuildInfo::GithubRepo + "issues/\".");
+            }
+            return true;
         }
-        return true;
+    }
+
+    inline bool InitializeMFWork(int argc, char* argv[]) {
+        if (Global::GlobalSettings.Init.Profile) Profiling::Enable();
+        bool initialized = Internal::Initialize(argc, argv);
+        if (Profiling::Enabled()) Profiling::PrintSummary(MF::Print::LogLevel::Debug);
+        return initialized;
     }
 }
@@ -0,0 +1,410 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "../Time&Date/CycleTimer.hpp"
+#include "../Files/FilesManager.hpp"
+#include "../../Outer/Print/Print.hpp"
+
+// scoped profiling zones.
+//   MF_PROFILE_SCOPE("name");   // times the rest of the enclosing block
+//   MF_PROFILE_FUNCTION();      // same, named after the function
+// zones only record while profiling is enabled (MF::Profiling::Enable); otherwise a zone costs one
+// relaxed load. a recorded zone is two cycle-counter reads and one store into a buffer owned by
+// its thread, no locks. define MF_DISABLE_PROFILING to compile the macros out altogether.
+// names must outlive the profiler (string literals, __func__).
+//
+// Collect() gathers what every thread recorded; from there ExportChromeTrace writes the JSON that
+// chrome://tracing and ui.perfetto.dev open, and PrintSummary logs the zones as a call tree.
+namespace MF::Profiling {
+
+    struct ZoneEvent {
+        const char* name;
+        std::uint64_t begin;
+        std::uint64_t end;
+        std::uint32_t depth;
+    };
+
+    namespace Internal {
+        // a thread's events: a list of fixed blocks, so the owner appends without locking and
+        // readers walk what is published (count is released after the event is written)
+        struct Block {
+            static constexpr size_t Capacity = 4096;
+            ZoneEvent events[Capacity];
+            std::atomic<size_t> count{0};
+            std::atomic<Block*> next{nullptr};
+        };
+
+        // Clear doesn't touch the blocks of a live thread: it asks for a reset (requested), and the
+        // owner drops its blocks on its next push. until then Collect skips the buffer
+        struct ThreadBuffer {
+            std::uint32_t thread = 0;
+            std::uint32_t depth = 0;
+            Block head;
+            Block* tail = &head;                          // owner only
+            std::mutex lock;                              // the owner's reset vs Collect and Clear
+            std::atomic<std::uint64_t> requested{0};      // resets asked for by Clear
+            std::uint64_t applied = 0;                    // resets done; written under lock
+            bool owned = true;                            // false once the thread exited; under lock
+
+            ThreadBuffer() = default;
+            ThreadBuffer(const ThreadBuffer&) = delete;
+            ThreadBuffer& operator=(const ThreadBuffer&) = delete;
+            ~ThreadBuffer() { dropBlocks(); }
+
+            // with lock held, by the owner or once there is none
+            void dropBlocks() {
+                Block* b = head.next.exchange(nullptr, std::memory_order_relaxed);
+                while (b) {
+                    Block* next = b->next.load(std::memory_order_relaxed);
+                    delete b;
+                    b = next;
+                }
+                head.count.store(0, std::memory_order_relaxed);
+                tail = &head;
+            }
+
+            bool pending() const { return requested.load(std::memory_order_relaxed) != applied; }
+
+            void applyClear() {
+                std::lock_guard<std::mutex> guard(lock);
+                dropBlocks();
+                applied = requested.load(std::memory_order_relaxed);
+            }
+
+            void push(const ZoneEvent& e) {
+                if (requested.load(std::memory_order_relaxed) != applied) applyClear();
+                size_t n = tail->count.load(std::memory_order_relaxed);
+                if (n == Block::Capacity) {
+                    Block* fresh = new Block();
+                    tail->next.store(fresh, std::memory_order_release);
+                    tail = fresh;
+                    n = 0;
+                }
+                tail->events[n] = e;
+                tail->count.store(n + 1, std::memory_order_release);
+            }
+        };
+
+        struct State {
+            std::atomic<bool> enabled{false};
+            std::mutex mutex;
+            // buffers stay here after their thread exits, so its zones can still be collected
+            std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+            std::uint32_t nextThread = 1;
+            std::uint64_t epoch = 0;
+        };
+
+        inline State& state() {
+            static State s;
+            return s;
+        }
+
+        // hands the buffer over to Clear when its thread exits
+        struct BufferOwner {
+            std::shared_ptr<ThreadBuffer> buffer;
+
+            ~BufferOwner() {
+                if (!buffer) return;
+                std::lock_guard<std::mutex> guard(buffer->lock);
+                if (buffer->pending()) {
+                    buffer->dropBlocks();
+                    buffer->applied = buffer->requested.load(std::memory_order_relaxed);
+                }
+                buffer->owned = false;
+            }
+        };
+
+        inline ThreadBuffer& threadBuffer() {
+            thread_local BufferOwner owner;
+            if (!owner.buffer) {
+                auto fresh = std::make_shared<ThreadBuffer>();
+                State& s = state();
+                std::lock_guard<std::mutex> lock(s.mutex);
+                fresh->thread = s.nextThread++;
+                s.buffers.push_back(fresh);
+                owner.buffer = std::move(fresh);
+            }
+            return *owner.buffer;
+        }
+
+        // a JSON string literal, quotes included
+        inline void appendJsonString(std::string& out, std::string_view s) {
+            static const char hex[] = "0123456789abcdef";
+            out += '"';
+            for (char ch : s) {
+                unsigned char c = static_cast<unsigned char>(ch);
+                switch (c) {
+                    case '"':  out += "\\\""; break;
+                    case '\\': out += "\\\\"; break;
+                    case '\n': out += "\\n"; break;
+                    case '\r': out += "\\r"; break;
+                    case '\t': out += "\\t"; break;
+                    default:
+                        if (c >= 0x20) {
+                            out += ch;
+                        } else {
+                            out += "\\u00";
+                            out += hex[c >> 4];
+                            out += hex[c & 0xF];
+                        }
+                }
+            }
+            out += '"';
+        }
+
+        inline bool hardwareClock() { return Time::cycles::source().hardware; }
+
+        inline std::uint64_t now() {
+            return hardwareClock() ? Time::cycles::counter() : Time::cycles::steadyNow();
+        }
+    }
+
+    inline bool Enabled() { return Internal::state().enabled.load(std::memory_order_relaxed); }
+
+    // starts recording; the first call calibrates the cycle counter (see CycleTimer.hpp)
+    inline void Enable(bool on = true) {
+        auto& s = Internal::state();
+        if (on) {
+            Time::cycles::source();
+            std::lock_guard<std::mutex> lock(s.mutex);
+            if (!s.epoch) s.epoch = Internal::now();
+        }
+        s.enabled.store(on, std::memory_order_relaxed);
+    }
+
+    class Zone {
+    public:
+        explicit Zone(const char* name) {
+            if (!Enabled()) return;
+            buffer_ = &Internal::threadBuffer();
+            name_ = name;
+            depth_ = buffer_->depth++;
+            begin_ = Internal::now();
+        }
+
+        ~Zone() {
+            if (!buffer_) return;
+            std::uint64_t end = Internal::now();
+            --buffer_->depth;
+            buffer_->push({name_, begin_, end, depth_});
+        }
+
+        Zone(const Zone&) = delete;
+        Zone& operator=(const Zone&) = delete;
+
+    private:
+        Internal::ThreadBuffer* buffer_ = nullptr;
+        const char* name_ = nullptr;
+        std::uint64_t begin_ = 0;
+        std::uint32_t depth_ = 0;
+    };
+
+    // one thread's zones, in the order they ended
+    struct ThreadTrace {
+        std::uint32_t thread = 0;
+        std::vector<ZoneEvent> events;
+    };
+
+    // everything recorded so far. safe while other threads keep recording (their newest zones may
+    // be missing); timestamps are counter ticks, see ToNs
+    inline std::vector<ThreadTrace> Collect() {
+        auto& s = Internal::state();
+        std::vector<std::shared_ptr<Internal::ThreadBuffer>> buffers;
+        {
+            std::lock_guard<std::mutex> lock(s.mutex);
+            buffers = s.buffers;
+        }
+        std::vector<ThreadTrace> out;
+        for (const auto& buffer : buffers) {
+            ThreadTrace trace;
+            trace.thread = buffer->thread;
+            // the lock keeps the owner from dropping the blocks while they are read
+            std::lock_guard<std::mutex> guard(buffer->lock);
+            if (buffer->pending()) continue;
+            for (const Internal::Block* b = &buffer->head; b; b = b->next.load(std::memory_order_acquire)) {
+                size_t n = b->count.load(std::memory_order_acquire);
+                trace.events.insert(trace.events.end(), b->events, b->events + n);
+            }
+            if (!trace.events.empty()) out.push_back(std::move(trace));
+        }
+        return out;
+    }
+
+    // drops recorded zones; safe while other threads record. a live thread frees its blocks on
+    // its next zone, the ones of exited threads go right away
+    inline void Clear() {
+        auto& s = Internal::state();
+        std::lock_guard<std::mutex> lock(s.mutex);
+        for (auto& buffer : s.buffers) {
+            std::lock_guard<std::mutex> guard(buffer->lock);
+            if (buffer->owned) buffer->requested.fetch_add(1, std::memory_order_relaxed);
+            else buffer->dropBlocks();
+        }
+        s.epoch = Internal::now();
+    }
+
+    // counter ticks since Enable -> ns
+    inline double ToNs(std::uint64_t ticks) {
+        std::uint64_t epoch = Internal::state().epoch;
+        return static_cast<double>(ticks >= epoch ? ticks - epoch : 0) * Time::cycles::source().nsPerTick;
+    }
+
+    // aggregated call tree: one node per distinct path of zone names, over all threads
+    struct ZoneNode {
+        std::string name;
+        std::uint64_t calls = 0;
+        double totalNs = 0.0;
+        double selfNs = 0.0;
+        double minNs = 0.0;
+        double maxNs = 0.0;
+        std::vector<std::unique_ptr<ZoneNode>> children;
+
+        ZoneNode& child(const char* childName) {
+            for (auto& c : children) {
+                if (c->name == childName) return *c;
+            }
+            children.push_back(std::make_unique<ZoneNode>());
+            children.back()->name = childName;
+            return *children.back();
+        }
+    };
+
+    inline ZoneNode BuildCallTree(const std::vector<ThreadTrace>& traces) {
+        ZoneNode root;
+        root.name = "<root>";
+        const double nsPerTick = Time::cycles::source().nsPerTick;
+        for (const auto& trace : traces) {
+            // zones are stored as they ended; in start order, each one's parent is the innermost
+            // zone still open
+            std::vector<const ZoneEvent*> order;
+            order.reserve(trace.events.size());
+            for (const auto& e : trace.events) order.push_back(&e);
+            std::stable_sort(order.begin(), order.end(), [](const ZoneEvent* a, const ZoneEvent* b) {
+                return a->begin != b->begin ? a->begin < b->begin : a->depth < b->depth;
+            });
+
+            std::vector<std::pair<const ZoneEvent*, ZoneNode*>> open;
+            for (const ZoneEvent* e : order) {
+                while (!open.empty() && (open.back().first->end <= e->begin || open.back().first->depth >= e->depth)) open.pop_back();
+                ZoneNode& parent = open.empty() ? root : *open.back().second;
+                ZoneNode& node = parent.child(e->name);
+                double ns = static_cast<double>(e->end - e->begin) * nsPerTick;
+                node.minNs = node.calls ? std::min(node.minNs, ns) : ns;
+                node.maxNs = node.calls ? std::max(node.maxNs, ns) : ns;
+                ++node.calls;
+                node.totalNs += ns;
+                node.selfNs += ns;
+                if (!open.empty()) open.back().second->selfNs -= ns;
+                open.emplace_back(e, &node);
+            }
+        }
+        for (auto& c : root.children) root.totalNs += c->totalNs;
+        return root;
+    }
+
+    // Chrome trace event format ("X" complete events, times in microseconds)
+    inline std::string ChromeTraceJson(const std::vector<ThreadTrace>& traces) {
+        std::string out = "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+        size_t events = 0;
+        for (const auto& trace : traces) events += trace.events.size();
+        out.reserve(out.size() + events * 96);
+        char number[64];
+        auto appendNumber = [&](double v) {
+            auto res = std::to_chars(number, number + sizeof(number), v, std::chars_format::fixed, 3);
+            out.append(number, res.ptr);
+        };
+        // names are few and repeat; escape each once
+        std::unordered_map<const char*, std::string> names;
+        const double nsPerTick = Time::cycles::source().nsPerTick;
+        bool first = true;
+        for (const auto& trace : traces) {
+            const std::string tid = std::to_string(trace.thread);
+            out += first ? "" : ",";
+            first = false;
+            out += "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":";
+            out += tid;
+            out += ",\"args\":{\"name\":\"thread ";
+            out += tid;
+            out += "\"}}";
+            for (const auto& e : trace.events) {
+                auto name = names.find(e.name);
+                if (name == names.end()) {
+                    std::string escaped;
+                    Internal::appendJsonString(escaped, e.name);
+                    name = names.emplace(e.name, std::move(escaped)).first;
+                }
+                out += ",{\"name\":";
+                out += name->second;
+                out += ",\"cat\":\"mf\",\"ph\":\"X\",\"ts\":";
+                appendNumber(ToNs(e.begin) / 1000.0);
+                out += ",\"dur\":";
+                appendNumber(static_cast<double>(e.end - e.begin) * nsPerTick / 1000.0);
+                out += ",\"pid\":1,\"tid\":";
+                out += tid;
+                out += '}';
+            }
+        }
+        out += "]}\n";
+        return out;
+    }
+
+    inline bool ExportChromeTrace(const std::string& filename) {
+        return !FilesManager::WriteStringToFile(filename, ChromeTraceJson(Collect())).has_value();
+    }
+
+    namespace Internal {
+        inline std::string formatNs(double ns) {
+            Time::DurationText text;
+            auto p = ns < 1e3 ? Time::Timer::Precision::Nanoseconds : ns < 1e6 ? Time::Timer::Precision::Microseconds : Time::Timer::Precision::Milliseconds;
+            auto res = Time::Timer::formatElapsedTo(text.data, text.data + Time::DurationText::Capacity,
+                                                    Time::ns_t(static_cast<long long>(ns + 0.5)), p);
+            return std::string(text.data, res.ptr);
+        }
+
+        inline void summaryLines(const ZoneNode& node, int level, std::vector<std::string>& lines) {
+            char line[256];
+            std::string label(static_cast<size_t>(level) * 2, ' ');
+            label += node.name;
+            std::snprintf(line, sizeof(line), "%-40s %8llu %12s %12s %12s %12s", label.c_str(), static_cast<unsigned long long>(node.calls),
+                          formatNs(node.totalNs).c_str(), formatNs(node.selfNs).c_str(), formatNs(node.totalNs / static_cast<double>(node.calls)).c_str(),
+                          formatNs(node.maxNs).c_str());
+            lines.emplace_back(line);
+            for (const auto& c : node.children) summaryLines(*c, level + 1, lines);
+        }
+    }
+
+    // the call tree as a table, one Print::Out line per zone
+    inline void PrintSummary(Print::LogLevel level = Print::LogLevel::Info) {
+        ZoneNode root = BuildCallTree(Collect());
+        if (root.children.empty()) {
+            Print::Out(level, "Profiler: no zones recorded.");
+            return;
+        }
+        char header[256];
+        std::snprintf(header, sizeof(header), "%-40s %8s %12s %12s %12s %12s", "zone", "calls", "total", "self", "avg", "max");
+        Print::Out(level, header);
+        std::vector<std::string> lines;
+        for (const auto& c : root.children) Internal::summaryLines(*c, 0, lines);
+        for (const auto& l : lines) Print::Out(level, l);
+    }
+}
+
+#ifndef MF_DISABLE_PROFILING
+#define MF_PROFILE_CONCAT_INNER(a, b) a##b
+#define MF_PROFILE_CONCAT(a, b) MF_PROFILE_CONCAT_INNER(a, b)
+#define MF_PROFILE_SCOPE(name) ::MF::Profiling::Zone MF_PROFILE_CONCAT(mf_profile_zone_, __LINE__)(name)
+#define MF_PROFILE_FUNCTION() MF_PROFILE_SCOPE(__func__)
+#else
+#define MF_PROFILE_SCOPE(name) ((void)0)
+#define MF_PROFILE_FUNCTION() ((void)0)
+#endif
@@ -0,0 +1,567 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+#include "../../Time&Date/Misc.hpp"
+#include "../../../Outer/Print/Print.hpp"
+
+// delayed and periodic tasks on a hierarchical timing wheel.
+//   MF::Runtime::Scheduler scheduler;
+//   scheduler.Start();                                   // or call Poll() from an event loop
+//   auto id = scheduler.Schedule("every 5m", [] { ... });
+//   scheduler.Schedule("in 1h 30m", [] { ... });
+//   scheduler.Cancel(id);
+// TimerWheel is the single-threaded core; Scheduler adds the lock, the driver thread and specs.
+namespace MF::Runtime {
+
+    using TimerId = std::uint64_t;
+
+    // what a spec asks for: first run after `delay`, then every `period` (zero: once)
+    struct ScheduleSpec {
+        Time::ns_t delay{0};
+        Time::ns_t period{0};
+
+        bool Repeating() const { return period.count() > 0; }
+    };
+
+    namespace Internal {
+        inline std::string_view trim(std::string_view s) {
+            while (!s.empty() && Time::detail::isSpace(s.front())) s.remove_prefix(1);
+            while (!s.empty() && Time::detail::isSpace(s.back())) s.remove_suffix(1);
+            return s;
+        }
+
+        // strips `word` and the spaces after it when `s` starts with it (any case)
+        inline bool takeWord(std::string_view& s, std::string_view word) {
+            if (s.size() <= word.size() || !Time::detail::isSpace(s[word.size()])) return false;
+            for (size_t i = 0; i < word.size(); ++i) {
+                if (Time::detail::toLower(s[i]) != word[i]) return false;
+            }
+            s = trim(s.substr(word.size()));
+            return true;
+        }
+
+        // position of " in " / " after " inside an "every" spec, npos if none
+        inline size_t findClause(std::string_view s, std::string_view& word) {
+            for (size_t i = 1; i + 1 < s.size(); ++i) {
+                if (!Time::detail::isSpace(s[i - 1])) continue;
+                std::string_view rest = s.substr(i);
+                for (std::string_view w : {std::string_view("in"), std::string_view("after")}) {
+                    std::string_view probe = rest;
+                    if (takeWord(probe, w)) {
+                        word = w;
+                        return i;
+                    }
+                }
+            }
+            return std::string_view::npos;
+        }
+
+        // bit helpers for the wheel's slot bitmaps (what <bit> has from C++20 on); v > 0
+        inline int log2Floor(std::uint64_t v) {
+#if defined(__GNUC__) || defined(__clang__)
+            return 63 - __builtin_clzll(v);
+#else
+            int r = 0;
+            while (v >>= 1) ++r;
+            return r;
+#endif
+        }
+
+        inline int countTrailingZeros(std::uint64_t v) {
+#if defined(__GNUC__) || defined(__clang__)
+            return __builtin_ctzll(v);
+#else
+            int r = 0;
+            while (!(v & 1)) {
+                v >>= 1;
+                ++r;
+            }
+            return r;
+#endif
+        }
+
+        inline std::uint64_t rotateRight(std::uint64_t v, int n) { return n ? (v >> n) | (v << (64 - n)) : v; }
+    }
+
+    // "every 5m", "every 1h in 10s" (first run after 10s), "in 1h 30m", "after 250ms", or a bare
+    // duration (same as "in"). durations are anything Time::parseDuration reads
+    inline std::optional<ScheduleSpec> ParseSchedule(std::string_view spec) {
+        std::string_view s = Internal::trim(spec);
+        ScheduleSpec out;
+        if (Internal::takeWord(s, "every")) {
+            std::string_view word;
+            size_t clause = Internal::findClause(s, word);
+            auto period = Time::parseDuration(s.substr(0, clause));
+            if (!period || period->count() <= 0) return std::nullopt;
+            out.period = *period;
+            out.delay = *period;
+            if (clause != std::string_view::npos) {
+                std::string_view first = s.substr(clause);
+                Internal::takeWord(first, word);
+                auto delay = Time::parseDuration(first);
+                if (!delay || delay->count() < 0) return std::nullopt;
+                out.delay = *delay;
+            }
+            return out;
+        }
+        if (!Internal::takeWord(s, "in")) Internal::takeWord(s, "after");
+        auto delay = Time::parseDuration(s);
+        if (!delay || delay->count() < 0) return std::nullopt;
+        out.delay = *delay;
+        return out;
+    }
+
+    // hashed hierarchical timing wheel (Varghese & Lauck): 6 levels of 64 slots, each level 64
+    // times coarser than the one below, so 2^36 ticks (795 days at 1 ms) are covered and later
+    // deadlines wait in the top level. a timer sits in one slot's index array; schedule and cancel are
+    // O(1), and a timer moves down at most once per level before it fires. a bitmap per level
+    // finds the next occupied slot, so Advance jumps over idle time instead of stepping each tick.
+    // not thread-safe; see Scheduler.
+    class TimerWheel {
+    public:
+        using Callback = std::function<void()>;
+        using Clock = std::chrono::steady_clock;
+
+        static constexpr int SlotBits = 6;
+        static constexpr int Slots = 1 << SlotBits;
+        static constexpr int Levels = 6;
+
+        explicit TimerWheel(Time::ns_t tick = std::chrono::milliseconds(1), Clock::time_point origin = Clock::now())
+            : tick_(tick.count() > 0 ? tick : Time::ns_t(1)), origin_(origin) {
+            bitmaps_.fill(0);
+        }
+
+        TimerWheel(const TimerWheel&) = delete;
+        TimerWheel& operator=(const TimerWheel&) = delete;
+
+        // room for `timers` without reallocating
+        void Reserve(size_t timers) {
+            links_.reserve(timers);
+            tasks_.reserve(timers);
+            free_.reserve(timers);
+        }
+
+        // fires once `delay` from now, then every `period` if it is positive
+        TimerId Schedule(Time::ns_t delay, Callback callback, Time::ns_t period = Time::ns_t::zero()) {
+            return ScheduleAt(Clock::now() + delay, std::move(callback), period);
+        }
+
+        TimerId ScheduleAt(Clock::time_point when, Callback callback, Time::ns_t period = Time::ns_t::zero()) {
+            std::uint64_t periodTicks = period.count() > 0 ? std::max<std::uint64_t>(1, ceilTicks(period)) : 0;
+            return add(ceilTicks(when - origin_), periodTicks, std::move(callback));
+        }
+
+        // false if the timer already fired (one-shot) or was cancelled
+        bool Cancel(TimerId id) {
+            std::uint32_t index;
+            if (!resolve(id, index)) return false;
+            if (index == firing_) {
+                tasks_[index].cancelled = true;
+                return true;
+            }
+            unlink(index);
+            release(index);
+            return true;
+        }
+
+        // runs every timer due at `now`, in deadline order (timers due in the same tick in no
+        // particular order). returns how many fired
+        size_t Advance(Clock::time_point now) {
+            return Advance(now, [](Callback& callback) { callback(); });
+        }
+
+        // same, calling invoke(callback) for each timer instead of callback() (Scheduler releases
+        // its lock around it). callbacks may schedule and cancel, but not advance the wheel
+        template <typename Invoke>
+        size_t Advance(Clock::time_point now, Invoke&& invoke) {
+            if (advancing_) return 0;
+            advancing_ = true;
+            std::uint64_t target = floorTicks(now - origin_);
+            size_t fired = 0;
+            while (true) {
+                std::uint64_t t = nextEventTick();
+                if (t > target) break;
+                now_ = t;
+                for (int level = Levels - 1; level >= 1; --level) {
+                    if ((t & ((std::uint64_t(1) << (SlotBits * level)) - 1)) == 0) {
+                        cascade(level, static_cast<int>((t >> (SlotBits * level)) & (Slots - 1)));
+                    }
+                }
+                fired += fire(static_cast<int>(t & (Slots - 1)), target, invoke);
+            }
+            if (target > now_) now_ = target;
+            advancing_ = false;
+            return fired;
+        }
+
+        // when Advance next has work: the earliest deadline, or earlier when a coarse slot has to
+        // be split. nullopt when nothing is scheduled
+        std::optional<Clock::time_point> NextExpiry() const {
+            std::uint64_t t = nextEventTick();
+            if (t == NoTick) return std::nullopt;
+            return timeOf(t);
+        }
+
+        // when `id` fires, nullopt if it isn't pending
+        std::optional<Clock::time_point> Expiry(TimerId id) const {
+            std::uint32_t index;
+            if (!resolve(id, index)) return std::nullopt;
+            return timeOf(links_[index].deadline);
+        }
+
+        size_t Pending() const { return pending_; }
+        Time::ns_t Tick() const { return tick_; }
+
+    private:
+        static constexpr std::uint32_t Null = std::numeric_limits<std::uint32_t>::max();
+        static constexpr std::uint32_t Firing = Levels * Slots;   // the list being fired
+        static constexpr std::uint32_t Unlinked = Firing + 1;
+        static constexpr std::uint32_t Free = Firing + 2;
+        static constexpr std::uint64_t NoTick = std::numeric_limits<std::uint64_t>::max();
+        static constexpr std::uint64_t Span = std::uint64_t(1) << (SlotBits * Levels);
+
+        // where a timer is, apart from what it runs: moving timers between slots touches 16 bytes each
+        struct Link {
+            std::uint64_t deadline = 0;
+            std::uint32_t slot = Free;
+            std::uint32_t position = 0;   // in slots_[slot]
+        };
+
+        struct Task {
+            std::uint64_t period = 0;
+            std::uint32_t generation = 0;
+            bool cancelled = false;
+            Callback callback;
+        };
+
+        Time::ns_t tick_;
+        Clock::time_point origin_;
+        std::uint64_t now_ = 0;   // last tick processed
+        std::vector<Link> links_;
+        std::vector<Task> tasks_;
+        std::vector<std::uint32_t> free_;
+        // each slot is an array of timer indices: add appends, remove swaps the last one into the
+        // gap, and a slot's timers can be walked without chasing pointers from one to the next
+        std::array<std::vector<std::uint32_t>, Levels * Slots + 1> slots_;
+        std::array<std::uint64_t, Levels> bitmaps_;
+        size_t pending_ = 0;
+        std::vector<std::uint32_t> moving_;
+        std::uint32_t firing_ = Null;
+        bool advancing_ = false;
+
+        std::uint64_t floorTicks(Time::ns_t d) const { return d.count() <= 0 ? 0 : static_cast<std::uint64_t>(d.count() / tick_.count()); }
+        std::uint64_t ceilTicks(Time::ns_t d) const {
+            return d.count() <= 0 ? 0 : static_cast<std::uint64_t>((d.count() + tick_.count() - 1) / tick_.count());
+        }
+        Clock::time_point timeOf(std::uint64_t t) const {
+            return origin_ + std::chrono::duration_cast<Clock::duration>(tick_ * static_cast<long long>(t));
+        }
+
+        static TimerId makeId(std::uint32_t index, std::uint32_t generation) {
+            return (static_cast<TimerId>(generation) << 32) | (static_cast<TimerId>(index) + 1);
+        }
+
+        bool resolve(TimerId id, std::uint32_t& index) const {
+            if (!id) return false;
+            index = static_cast<std::uint32_t>((id & 0xFFFFFFFFu) - 1);
+            return index < links_.size() && tasks_[index].generation == static_cast<std::uint32_t>(id >> 32) && links_[index].slot != Free &&
+                   !tasks_[index].cancelled;
+        }
+
+        TimerId add(std::uint64_t deadline, std::uint64_t period, Callback callback) {
+            std::uint32_t index;
+            if (!free_.empty()) {
+                index = free_.back();
+                free_.pop_back();
+            } else {
+                index = static_cast<std::uint32_t>(links_.size());
+                links_.emplace_back();
+                tasks_.emplace_back();
+            }
+            Task& task = tasks_[index];
+            task.period = period;
+            task.cancelled = false;
+            task.callback = std::move(callback);
+            // the current tick has been processed; anything due by now fires on the next one
+            links_[index].deadline = std::max(deadline, now_ + 1);
+            links_[index].slot = Unlinked;
+            place(index);
+            ++pending_;
+            return makeId(index, task.generation);
+        }
+
+        void release(std::uint32_t index) {
+            Task& task = tasks_[index];
+            task.callback = nullptr;
+            task.cancelled = false;
+            ++task.generation;
+            links_[index].slot = Free;
+            free_.push_back(index);
+            --pending_;
+        }
+
+        void link(std::uint32_t index, std::uint32_t slot) {
+            Link& n = links_[index];
+            auto& list = slots_[slot];
+            n.slot = slot;
+            n.position = static_cast<std::uint32_t>(list.size());
+            list.push_back(index);
+            if (slot < Firing) bitmaps_[slot / Slots] |= std::uint64_t(1) << (slot % Slots);
+        }
+
+        void unlink(std::uint32_t index) {
+            Link& n = links_[index];
+            if (n.slot >= Unlinked) return;
+            auto& list = slots_[n.slot];
+            std::uint32_t last = list.back();
+            list[n.position] = last;
+            links_[last].position = n.position;
+            list.pop_back();
+            if (list.empty() && n.slot < Firing) bitmaps_[n.slot / Slots] &= ~(std::uint64_t(1) << (n.slot % Slots));
+            n.slot = Unlinked;
+        }
+
+        // the lowest level whose range still reaches the deadline; slot by the deadline's digit there
+        void place(std::uint32_t index) {
+            std::uint64_t deadline = links_[index].deadline;
+            std::uint64_t delta = deadline > now_ ? deadline - now_ : 0;
+            if (delta >= Span) {
+                // past the top level's range: park at its far end, moved again when that slot comes up
+                deadline = now_ + Span - 1;
+                delta = Span - 1;
+            }
+            int level = delta < Slots ? 0 : Internal::log2Floor(delta) / SlotBits;
+            std::uint32_t slot = static_cast<std::uint32_t>((deadline >> (SlotBits * level)) & (Slots - 1));
+            link(index, static_cast<std::uint32_t>(level * Slots) + slot);
+        }
+
+        // first tick after now_ at which an occupied slot comes up, NoTick if the wheel is empty
+        std::uint64_t nextEventTick() const {
+            std::uint64_t best = NoTick;
+            for (int level = 0; level < Levels; ++level) {
+                std::uint64_t bits = bitmaps_[level];
+                if (!bits) continue;
+                int shift = SlotBits * level;
+                std::uint64_t current = now_ >> shift;
+                // distance (1..64) to the next occupied slot after the current one, wrapping around
+                int from = static_cast<int>((current + 1) & (Slots - 1));
+                std::uint64_t distance = static_cast<std::uint64_t>(Internal::countTrailingZeros(Internal::rotateRight(bits, from))) + 1;
+                std::uint64_t t = level == 0 ? now_ + distance : (current + distance) << shift;
+                best = std::min(best, t);
+            }
+            return best;
+        }
+
+        // a coarse slot came up: its timers move to finer levels
+        void cascade(int level, int slot) {
+            auto& list = slots_[static_cast<size_t>(level * Slots + slot)];
+            moving_.swap(list);
+            bitmaps_[level] &= ~(std::uint64_t(1) << slot);
+            for (std::uint32_t index : moving_) {
+                links_[index].slot = Unlinked;
+                place(index);
+            }
+            // hand the capacity back to the slot for its next round
+            moving_.clear();
+            if (list.empty()) moving_.swap(list);
+        }
+
+        template <typename Invoke>
+        size_t fire(int slot, std::uint64_t target, Invoke& invoke) {
+            // the slot becomes the firing list first: a callback may cancel any timer in it
+            auto& firing = slots_[Firing];
+            firing.swap(slots_[static_cast<size_t>(slot)]);
+            bitmaps_[0] &= ~(std::uint64_t(1) << slot);
+            for (std::uint32_t index : firing) links_[index].slot = Firing;
+            size_t fired = 0;
+            while (!firing.empty()) {
+                std::uint32_t index = firing.back();
+                unlink(index);
+                if (links_[index].deadline > now_) {
+                    place(index);
+                    continue;
+                }
+                ++fired;
+                Callback callback = std::move(tasks_[index].callback);
+                if (!tasks_[index].period) {
+                    release(index);
+                    invoke(callback);
+                    continue;
+                }
+                firing_ = index;
+                invoke(callback);
+                firing_ = Null;
+                // references are taken again: callbacks may have grown the vectors
+                Task& task = tasks_[index];
+                if (task.cancelled) {
+                    release(index);
+                    continue;
+                }
+                // fixed rate; periods missed while the wheel wasn't advanced are skipped, so the next
+                // deadline is the first one after the tick this Advance runs up to
+                std::uint64_t& deadline = links_[index].deadline;
+                deadline += task.period;
+                if (deadline <= target) deadline += ((target - deadline) / task.period + 1) * task.period;
+                task.callback = std::move(callback);
+                place(index);
+            }
+            return fired;
+        }
+    };
+
+    // TimerWheel behind a mutex, driven by its own thread (Start) or by the caller (Poll). callbacks
+    // run on the driving thread without the lock held, so they can schedule and cancel; an
+    // exception from one is logged and the timer carries on.
+    class Scheduler {
+    public:
+        using Callback = TimerWheel::Callback;
+        using Clock = TimerWheel::Clock;
+
+        explicit Scheduler(Time::ns_t tick = std::chrono::milliseconds(1)) : wheel_(tick) {}
+        ~Scheduler() { Stop(); }
+
+        Scheduler(const Scheduler&) = delete;
+        Scheduler& operator=(const Scheduler&) = delete;
+
+        // see ParseSchedule; 0 if the spec doesn't parse
+        TimerId Schedule(std::string_view spec, Callback callback) {
+            auto parsed = ParseSchedule(spec);
+            if (!parsed) {
+                Print::Out(Print::LogLevel::Warning, "Scheduler: can't parse schedule \"" + std::string(spec) + "\".");
+                return 0;
+            }
+            return Schedule(*parsed, std::move(callback));
+        }
+
+        TimerId Schedule(const ScheduleSpec& spec, Callback callback) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            TimerId id = wheel_.Schedule(spec.delay, std::move(callback), spec.period);
+            wakeIfEarlier(id);
+            return id;
+        }
+
+        TimerId After(Time::ns_t delay, Callback callback) { return Schedule(ScheduleSpec{delay, Time::ns_t::zero()}, std::move(callback)); }
+        TimerId Every(Time::ns_t period, Callback callback) { return Schedule(ScheduleSpec{period, period}, std::move(callback)); }
+        TimerId Every(Time::ns_t period, Time::ns_t firstDelay, Callback callback) {
+            return Schedule(ScheduleSpec{firstDelay, period}, std::move(callback));
+        }
+
+        bool Cancel(TimerId id) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            return wheel_.Cancel(id);
+        }
+
+        // a Timer started now whose threshold is the time left until `id` fires, so
+        // reachedThreshold() tells whether it is due; nullopt if it isn't pending
+        std::optional<Time::Timer> Deadline(TimerId id) const {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto expiry = wheel_.Expiry(id);
+            if (!expiry) return std::nullopt;
+            Time::Timer timer(Time::Timer::Precision::Milliseconds);
+            timer.setThreshold(std::max(Time::ns_t::zero(), std::chrono::duration_cast<Time::ns_t>(*expiry - Clock::now())));
+            timer.start();
+            return timer;
+        }
+
+        // starts the driver thread; it sleeps until the next expiry or an earlier new timer
+        void Start() {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (running_) return;
+            running_ = true;
+            driver_ = std::thread([this] { drive(); });
+        }
+
+        void Stop() {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (!running_) return;
+                running_ = false;
+            }
+            wake_.notify_all();
+            if (driver_.joinable()) driver_.join();
+        }
+
+        bool Running() const {
+            std::lock_guard<std::mutex> lock(mutex_);
+            return running_;
+        }
+
+        // for event loops instead of Start: runs what is due on the calling thread
+        size_t Poll() {
+            std::unique_lock<std::mutex> lock(mutex_);
+            return advance(lock);
+        }
+
+        // how long an event loop may wait before the next Poll; nullopt when nothing is scheduled
+        std::optional<Time::ns_t> NextTimeout() const {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto next = wheel_.NextExpiry();
+            if (!next) return std::nullopt;
+            return std::max(Time::ns_t::zero(), std::chrono::duration_cast<Time::ns_t>(*next - Clock::now()));
+        }
+
+        size_t Pending() const {
+            std::lock_guard<std::mutex> lock(mutex_);
+            return wheel_.Pending();
+        }
+
+        void Reserve(size_t timers) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            wheel_.Reserve(timers);
+        }
+
+    private:
+        TimerWheel wheel_;
+        mutable std::mutex mutex_;
+        std::condition_variable wake_;
+        std::thread driver_;
+        bool running_ = false;
+        Clock::time_point wakeAt_ = Clock::time_point::max();
+
+        size_t advance(std::unique_lock<std::mutex>& lock) {
+            return wheel_.Advance(Clock::now(), [&](Callback& callback) {
+                lock.unlock();
+                try {
+                    callback();
+                } catch (const std::exception& e) {
+                    Print::Out(Print::LogLevel::Error, "Scheduler: task threw: " + std::string(e.what()));
+                } catch (...) {
+                    Print::Out(Print::LogLevel::Error, "Scheduler: task threw an unknown exception.");
+                }
+                lock.lock();
+            });
+        }
+
+        void wakeIfEarlier(TimerId id) {
+            if (!running_) return;
+            auto expiry = wheel_.Expiry(id);
+            if (expiry && *expiry < wakeAt_) {
+                wakeAt_ = *expiry;
+                wake_.notify_one();
+            }
+        }
+
+        void drive() {
+            std::unique_lock<std::mutex> lock(mutex_);
+            while (running_) {
+                advance(lock);
+                if (!running_) break;
+                auto next = wheel_.NextExpiry();
+                wakeAt_ = next ? *next : Clock::time_point::max();
+                if (next) wake_.wait_until(lock, *next);
+                else wake_.wait(lock);
+            }
+        }
+    };
+}
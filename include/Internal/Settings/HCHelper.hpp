@@ -98,7 +98,8 @@ namespace MF::InternalSettings::Internal {
                     {"AutoDetermineLogLevel", settings->Init.AutoDetermineLogLevel},
                     {"ValidateSession", settings->Init.ValidateSession},
                     {"LogBuildChannel", settings->Init.LogBuildChannel},
-                    {"AlertOnUnstableChannel", settings->Init.AlertOnUnstableChannel}
+                    {"AlertOnUnstableChannel", settings->Init.AlertOnUnstableChannel},
+                    {"Profile", settings->Init.Profile}
                 };
 
                 for (auto& root : std::vector<std::string>{"Initialization", "InitializationSettings"}) {
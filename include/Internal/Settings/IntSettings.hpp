@@ -17,18 +17,58 @@ namespace MF::InternalSettings {
         MF::Global::GlobalSettings.Usable = true;
     }
 
-    inline void SetupHC(const std::string& filename) {
+    namespace Internal {
+        // overrides and mapping, once `helper` holds the config read from `source`
+        inline void FinishSetupHC(HCHelper& helper, const std::string& source, const Runtime::Arguments::Parser* arguments) {
+            // MF_CFG__* environment variables and --cfg.* arguments win over the file,
+            // unless the file itself turns overrides off
+            bool allowOverrides = MF::Global::GlobalSettings.Init.AllowOverrides;
+            for (const char* root : {"Initialization", "InitializationSettings"}) {
+                helper.CfgMgr.TryGetBool(std::string(root) + ".AllowOverrides", allowOverrides);
+            }
+            if (allowOverrides) {
+                helper.CfgMgr.ApplyOverrides(arguments ? arguments : &MF::Global::ArgumentParser);
+            }
+
+            if (!helper.Map(&MF::Global::GlobalSettings)) {
+                throw std::runtime_error("Failed to map settings from " + source);
+            }
+
+            MF::Global::GlobalSettings.Usable = true;
+        }
+    }
+
+    // `arguments` are checked for --cfg.* overrides; MF::Global::ArgumentParser is used when null
+    inline void SetupHC(const std::string& filename, const Runtime::Arguments::Parser* arguments = nullptr) {
         Internal::HCHelper helper;
 
         if (!helper.Load(filename)) {
             throw std::runtime_error("Failed to load settings file: " + filename);
         }
+        Internal::FinishSetupHC(helper, "file: " + filename, arguments);
+    }
+
+#ifndef _WIN32
+    // like SetupHC, with the settings taken from a snapshot an HCSharedPublisher keeps in shared
+    // memory under `segment` (see Configuration/Shared.hpp) instead of parsing the file again
+    inline void SetupHCShared(const std::string& segment, const Runtime::Arguments::Parser* arguments = nullptr) {
+        Configurations::Internal::Parser::HCSharedReader reader(segment);
+        auto snapshot = reader.Attach() ? reader.Current() : nullptr;
+        Internal::HCHelper helper;
 
-        if (!helper.Map(&MF::Global::GlobalSettings)) {
-            throw std::runtime_error("Failed to map settings from file: " + filename);
+        if (!snapshot || !helper.CfgMgr.LoadSnapshot(snapshot->View())) {
+            throw std::runtime_error("Failed to load settings snapshot: " + segment);
         }
+        Internal::FinishSetupHC(helper, "snapshot: " + segment, arguments);
+    }
+#endif
 
-        MF::Global::GlobalSettings.Usable = true;
+    // same as above, with --cfg.* overrides taken from the command line
+    // (before InitializeMFWork has parsed it into MF::Global::ArgumentParser)
+    inline void SetupHC(const std::string& filename, int argc, char* argv[]) {
+        Runtime::Arguments::Parser arguments;
+        arguments.Parse(argc, argv);
+        SetupHC(filename, &arguments);
     }
 
 }
@@ -17,6 +17,7 @@ namespace MF::InternalSettings {
             bool ValidateSession = true;
             bool LogBuildChannel = true;
             bool AlertOnUnstableChannel = true;
+            bool Profile = false;
         };
 
         struct Printing {
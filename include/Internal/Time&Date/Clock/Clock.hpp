@@ -0,0 +1,268 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <ctime>
+#include <limits>
+#include <mutex>
+#include <string>
+#include <thread>
+#include "../Format/Format.hpp"
+
+// clocks for code that stamps often (log lines, metrics), from cheapest to most precise:
+//   - with the ticker running (StartTicker), Now/MonotonicNow/Seconds are one atomic load of what
+//     a background thread published at most one interval ago
+//   - otherwise the coarse kernel clocks (CLOCK_REALTIME_COARSE, CLOCK_MONOTONIC_COARSE): no
+//     syscall through the vDSO, but only as fine as the kernel tick (see Resolution)
+//   - Realtime/Monotonic for full precision
+// TimeText/DateTimeText copy the local "YYYY-MM-DD HH:MM:SS" of the current second, formatted
+// once per second and shared between threads.
+namespace MF::Chrono::Clock {
+
+    enum class Kind { Realtime, RealtimeCoarse, Monotonic, MonotonicCoarse };
+
+    namespace Internal {
+        inline std::int64_t chronoNs(Kind kind) {
+            auto since = kind == Kind::Realtime || kind == Kind::RealtimeCoarse
+                ? std::chrono::system_clock::now().time_since_epoch()
+                : std::chrono::duration_cast<std::chrono::system_clock::duration>(std::chrono::steady_clock::now().time_since_epoch());
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(since).count();
+        }
+
+#ifndef _WIN32
+        inline clockid_t clockId(Kind kind) {
+            switch (kind) {
+#ifdef CLOCK_REALTIME_COARSE
+                case Kind::RealtimeCoarse:  return CLOCK_REALTIME_COARSE;
+#else
+                case Kind::RealtimeCoarse:  return CLOCK_REALTIME;
+#endif
+#ifdef CLOCK_MONOTONIC_COARSE
+                case Kind::MonotonicCoarse: return CLOCK_MONOTONIC_COARSE;
+#else
+                case Kind::MonotonicCoarse: return CLOCK_MONOTONIC;
+#endif
+                case Kind::Monotonic:       return CLOCK_MONOTONIC;
+                default:                    return CLOCK_REALTIME;
+            }
+        }
+#endif
+
+        // the last formatted second: a seqlock over the text, kept in atomic words so readers
+        // copying it while it is rewritten are not a data race
+        struct SecondText {
+            static constexpr size_t Size = 19;   // "YYYY-MM-DD HH:MM:SS"
+
+            std::atomic<std::uint64_t> sequence{0};
+            std::atomic<std::int64_t> second{std::numeric_limits<std::int64_t>::min()};
+            std::atomic<std::uint64_t> words[3] = {};
+            std::mutex write;
+
+            bool tryRead(std::int64_t s, char* out) const {
+                std::uint64_t s1 = sequence.load(std::memory_order_acquire);
+                if (s1 & 1) return false;
+                std::int64_t cached = second.load(std::memory_order_relaxed);
+                std::uint64_t copy[3];
+                for (int i = 0; i < 3; ++i) copy[i] = words[i].load(std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (sequence.load(std::memory_order_relaxed) != s1 || cached != s) return false;
+                std::memcpy(out, copy, Size);
+                return true;
+            }
+
+            // formats `s` into out (Size bytes); false for years that don't fit in four digits
+            static bool format(std::int64_t s, char* out) {
+                static const TimeFormat pattern("%Y-%m-%d %H:%M:%S");
+                char buffer[48];
+                auto res = pattern.FormatTo(buffer, buffer + sizeof(buffer), Timestamp{s, 0});
+                if (res.ptr - buffer != static_cast<std::ptrdiff_t>(Size)) return false;
+                std::memcpy(out, buffer, Size);
+                return true;
+            }
+
+            // publishing is best effort: a thread that finds another one writing keeps its copy
+            void publish(std::int64_t s, const char* text) {
+                std::unique_lock<std::mutex> lock(write, std::try_to_lock);
+                if (!lock.owns_lock() || second.load(std::memory_order_relaxed) >= s) return;
+                std::uint64_t copy[3] = {};
+                std::memcpy(copy, text, Size);
+                sequence.fetch_add(1, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_release);
+                for (int i = 0; i < 3; ++i) words[i].store(copy[i], std::memory_order_relaxed);
+                second.store(s, std::memory_order_relaxed);
+                sequence.fetch_add(1, std::memory_order_release);
+            }
+
+            void reset() {
+                std::lock_guard<std::mutex> lock(write);
+                sequence.fetch_add(1, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_release);
+                second.store(std::numeric_limits<std::int64_t>::min(), std::memory_order_relaxed);
+                sequence.fetch_add(1, std::memory_order_release);
+            }
+        };
+
+        struct State {
+            std::atomic<bool> ticking{false};
+            std::atomic<std::int64_t> realtime{0};    // ns since the epoch
+            std::atomic<std::int64_t> monotonic{0};   // ns
+            std::chrono::nanoseconds interval{std::chrono::milliseconds(1)};
+            SecondText text;
+
+            std::mutex lock;
+            std::condition_variable wake;
+            bool stopping = false;
+            std::thread ticker;
+
+            ~State() { stop(); }
+
+            void stop() {
+                std::unique_lock<std::mutex> guard(lock);
+                if (!ticker.joinable()) return;
+                stopping = true;
+                ticking.store(false, std::memory_order_relaxed);
+                wake.notify_all();
+                std::thread t = std::move(ticker);
+                guard.unlock();
+                t.join();
+            }
+        };
+
+        inline State& state() {
+            static State s;
+            return s;
+        }
+    }
+
+    // nanoseconds from the given clock
+    inline std::int64_t ReadNs(Kind kind) {
+#ifdef _WIN32
+        return Internal::chronoNs(kind);
+#else
+        timespec ts;
+        if (clock_gettime(Internal::clockId(kind), &ts) != 0) return Internal::chronoNs(kind);
+        return static_cast<std::int64_t>(ts.tv_sec) * 1'000'000'000 + ts.tv_nsec;
+#endif
+    }
+
+    // how far apart two readings of the clock can be, in ns (a few ms for the coarse ones)
+    inline std::int64_t Resolution(Kind kind) {
+#ifdef _WIN32
+        (void)kind;
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::duration(1)).count();
+#else
+        timespec ts;
+        if (clock_getres(Internal::clockId(kind), &ts) != 0) return 1;
+        return static_cast<std::int64_t>(ts.tv_sec) * 1'000'000'000 + ts.tv_nsec;
+#endif
+    }
+
+    inline Timestamp FromNs(std::int64_t ns) {
+        std::int64_t s = ns / 1'000'000'000;
+        std::int64_t rest = ns % 1'000'000'000;
+        if (rest < 0) {
+            rest += 1'000'000'000;
+            --s;
+        }
+        return {s, static_cast<std::uint32_t>(rest)};
+    }
+
+    inline Timestamp Realtime() { return FromNs(ReadNs(Kind::Realtime)); }
+    inline Timestamp RealtimeCoarse() { return FromNs(ReadNs(Kind::RealtimeCoarse)); }
+    inline std::int64_t Monotonic() { return ReadNs(Kind::Monotonic); }
+    inline std::int64_t MonotonicCoarse() { return ReadNs(Kind::MonotonicCoarse); }
+
+    inline bool Ticking() { return Internal::state().ticking.load(std::memory_order_acquire); }
+
+    // wall-clock time, at most one ticker interval (or one kernel tick) old
+    inline Timestamp Now() {
+        auto& s = Internal::state();
+        if (s.ticking.load(std::memory_order_acquire)) return FromNs(s.realtime.load(std::memory_order_relaxed));
+        return RealtimeCoarse();
+    }
+
+    // monotonic ns, as coarse as Now. the coarse clock runs up to a tick behind what a stopped
+    // ticker last published, so it doesn't go below that
+    inline std::int64_t MonotonicNow() {
+        auto& s = Internal::state();
+        if (s.ticking.load(std::memory_order_acquire)) return s.monotonic.load(std::memory_order_relaxed);
+        std::int64_t coarse = MonotonicCoarse();
+        std::int64_t published = s.monotonic.load(std::memory_order_relaxed);
+        return coarse > published ? coarse : published;
+    }
+
+    inline std::int64_t Seconds() { return Now().seconds; }
+
+    // writes the local "YYYY-MM-DD HH:MM:SS" of `second` (now by default) to out, which must hold
+    // 19 chars; returns 19, or 0 for years outside 0-9999
+    inline size_t DateTimeText(char* out, std::int64_t second) {
+        auto& text = Internal::state().text;
+        if (text.tryRead(second, out)) return Internal::SecondText::Size;
+        if (!Internal::SecondText::format(second, out)) return 0;
+        text.publish(second, out);
+        return Internal::SecondText::Size;
+    }
+
+    inline size_t DateTimeText(char* out) { return DateTimeText(out, Seconds()); }
+
+    // local "HH:MM:SS" of the current second; out must hold 8 chars. returns 8 (0 as above)
+    inline size_t TimeText(char* out) {
+        char full[Internal::SecondText::Size];
+        if (DateTimeText(full) != Internal::SecondText::Size) return 0;
+        std::memcpy(out, full + 11, 8);
+        return 8;
+    }
+
+    inline std::string DateTimeStr() {
+        char buffer[Internal::SecondText::Size];
+        return std::string(buffer, DateTimeText(buffer));
+    }
+
+    inline std::string TimeStr() {
+        char buffer[8];
+        return std::string(buffer, TimeText(buffer));
+    }
+
+    // after the process time zone changed; also resets the UTC offset cache (Civil.hpp)
+    inline void ResetTimeZone() {
+        ResetUtcOffsetCache();
+        Internal::state().text.reset();
+    }
+
+    // starts a thread that publishes the precise clocks every `interval` and keeps the text of
+    // the current second ready; Now and MonotonicNow then read what it published. calling it again
+    // changes the interval
+    inline void StartTicker(std::chrono::nanoseconds interval = std::chrono::milliseconds(1)) {
+        auto& s = Internal::state();
+        std::lock_guard<std::mutex> guard(s.lock);
+        s.interval = interval > std::chrono::nanoseconds(0) ? interval : std::chrono::milliseconds(1);
+        if (s.ticker.joinable()) {
+            s.wake.notify_all();
+            return;
+        }
+        s.stopping = false;
+        auto tick = [&s] {
+            std::int64_t real = ReadNs(Kind::Realtime);
+            s.realtime.store(real, std::memory_order_relaxed);
+            s.monotonic.store(ReadNs(Kind::Monotonic), std::memory_order_relaxed);
+            char text[Internal::SecondText::Size];
+            DateTimeText(text, FromNs(real).seconds);
+        };
+        tick();
+        s.ticking.store(true, std::memory_order_release);
+        s.ticker = std::thread([&s, tick] {
+            std::unique_lock<std::mutex> guard(s.lock);
+            while (!s.stopping) {
+                s.wake.wait_for(guard, s.interval);
+                if (s.stopping) break;
+                tick();
+            }
+        });
+    }
+
+    // Now and MonotonicNow go back to the coarse kernel clocks
+    inline void StopTicker() { Internal::state().stop(); }
+}
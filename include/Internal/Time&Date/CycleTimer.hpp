@@ -0,0 +1,273 @@
+#pragma once
+// MFWork/Internal/Time&Date/CycleTimer.hpp
+// cycle counter timer for sub-microsecond sections (header-only)
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include "Misc.hpp"
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#define MF_CYCLES_X86 1
+#elif defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#include <x86intrin.h>
+#define MF_CYCLES_X86 1
+#elif defined(__aarch64__)
+#define MF_CYCLES_ARM64 1
+#endif
+
+namespace Time {
+
+// the counter behind CycleTimer:
+//  - x86: the TSC (rdtsc, rdtscp to stop), only when the CPU reports it invariant (constant rate
+//    through frequency changes and idle states); ticks per ns are measured against steady_clock
+//  - arm64: the generic timer (cntvct_el0), whose rate the CPU states (cntfrq_el0)
+//  - anything else, or x86 without invariant TSC: steady_clock itself, one tick per ns
+namespace cycles {
+    struct Source {
+        const char* name = "steady_clock";
+        bool hardware = false;
+        bool invariant = false;
+        bool rdtscp = false;
+        double nsPerTick = 1.0;
+    };
+
+    inline std::uint64_t steadyNow() noexcept {
+        return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+    // hardware counter, not ordered against surrounding instructions
+    inline std::uint64_t counter() noexcept {
+#if defined(MF_CYCLES_X86)
+        return __rdtsc();
+#elif defined(MF_CYCLES_ARM64)
+        std::uint64_t v;
+        asm volatile("mrs %0, cntvct_el0" : "=r"(v));
+        return v;
+#else
+        return steadyNow();
+#endif
+    }
+
+    // start: later instructions don't begin before the counter is read
+    inline std::uint64_t counterBegin() noexcept {
+#if defined(MF_CYCLES_X86)
+        std::uint64_t v = __rdtsc();
+        _mm_lfence();
+        return v;
+#elif defined(MF_CYCLES_ARM64)
+        std::uint64_t v;
+        asm volatile("isb; mrs %0, cntvct_el0" : "=r"(v) :: "memory");
+        return v;
+#else
+        return steadyNow();
+#endif
+    }
+
+    // stop: earlier instructions have finished before the counter is read
+    inline std::uint64_t counterEnd(bool rdtscp) noexcept {
+#if defined(MF_CYCLES_X86)
+        if (rdtscp) {
+            unsigned aux;
+            std::uint64_t v = __rdtscp(&aux);
+            _mm_lfence();
+            return v;
+        }
+        _mm_lfence();
+        return __rdtsc();
+#elif defined(MF_CYCLES_ARM64)
+        (void)rdtscp;
+        std::uint64_t v;
+        asm volatile("isb; mrs %0, cntvct_el0" : "=r"(v) :: "memory");
+        return v;
+#else
+        (void)rdtscp;
+        return steadyNow();
+#endif
+    }
+
+#if defined(MF_CYCLES_X86)
+    inline void cpuid(unsigned leaf, unsigned regs[4]) {
+#if defined(_MSC_VER)
+        int r[4];
+        __cpuid(r, static_cast<int>(leaf));
+        for (int i = 0; i < 4; ++i) regs[i] = static_cast<unsigned>(r[i]);
+#else
+        __cpuid(leaf, regs[0], regs[1], regs[2], regs[3]);
+#endif
+    }
+#endif
+
+    // ns per counter tick against steady_clock, median of three windows
+    inline double measure(std::chrono::nanoseconds window) {
+        double results[3];
+        for (double& result : results) {
+            std::uint64_t t0 = steadyNow(), c0 = counter();
+            std::uint64_t t1, c1;
+            do {
+                t1 = steadyNow();
+                c1 = counter();
+            } while (t1 - t0 < static_cast<std::uint64_t>(window.count()) / 3);
+            result = c1 > c0 ? static_cast<double>(t1 - t0) / static_cast<double>(c1 - c0) : 0.0;
+        }
+        std::sort(results, results + 3);
+        return results[1];
+    }
+
+    // detects the counter and measures its rate; `window` is the time spent measuring (x86 only)
+    inline Source calibrate(std::chrono::nanoseconds window = std::chrono::milliseconds(10)) {
+        Source source;
+#if defined(MF_CYCLES_X86)
+        unsigned regs[4] = {0, 0, 0, 0};
+        cpuid(0x80000000u, regs);
+        unsigned maxExtended = regs[0];
+        if (maxExtended >= 0x80000001u) {
+            cpuid(0x80000001u, regs);
+            source.rdtscp = (regs[3] >> 27) & 1u;
+        }
+        if (maxExtended >= 0x80000007u) {
+            cpuid(0x80000007u, regs);
+            source.invariant = (regs[3] >> 8) & 1u;
+        }
+        if (source.invariant) {
+            double nsPerTick = measure(window);
+            if (nsPerTick > 0.0) {
+                source.name = source.rdtscp ? "rdtscp" : "rdtsc";
+                source.hardware = true;
+                source.nsPerTick = nsPerTick;
+            }
+        }
+#elif defined(MF_CYCLES_ARM64)
+        (void)window;
+        std::uint64_t frequency;
+        asm volatile("mrs %0, cntfrq_el0" : "=r"(frequency));
+        if (frequency) {
+            source.name = "cntvct";
+            source.hardware = true;
+            source.invariant = true;
+            source.nsPerTick = 1e9 / static_cast<double>(frequency);
+        }
+#else
+        (void)window;
+#endif
+        return source;
+    }
+
+    // calibrated on first use (about 10 ms on x86), call early to keep that out of measurements
+    inline const Source& source() {
+        static const Source calibrated = calibrate();
+        return calibrated;
+    }
+}
+
+// Timer's start/stop/lap/elapsed interface on the cycle counter. a reading costs a few ns instead
+// of a steady_clock call, and results are in ns precision by default.
+// CPUs can migrate the thread between start and stop; invariant TSCs are synchronized across
+// cores on current hardware, but very short sections should be timed on one thread.
+    class CycleTimer {
+    public:
+        using Precision = Timer::Precision;
+
+        explicit CycleTimer(Precision p = Precision::Nanoseconds)
+            : source_(&cycles::source()), precision_(p) {}
+
+        explicit CycleTimer(const std::string& unitToken)
+            : source_(&cycles::source()), precision_(Timer(unitToken).precision()) {}
+
+        // forces calibration now, e.g. at startup. returns the counter in use
+        static const cycles::Source& Calibrate() { return cycles::source(); }
+
+        void start() {
+            start_ = read(true);
+            last_lap_ = start_;
+            running_ = true;
+            started_ = true;
+        }
+
+        void stop() {
+            if (running_) {
+                end_ = read(false);
+                running_ = false;
+            }
+        }
+
+        void reset() {
+            running_ = false;
+            started_ = false;
+            start_ = end_ = last_lap_ = 0;
+        }
+
+        void restart() { reset(); start(); }
+
+        // duration since last lap or start
+        std::chrono::nanoseconds lap() {
+            if (!started_) return std::chrono::nanoseconds::zero();
+            std::uint64_t now = running_ ? read(false) : end_;
+            std::uint64_t ticks = now - last_lap_;
+            last_lap_ = now;
+            return toNs(ticks);
+        }
+
+        // see Timer::lapInto
+        template <typename Histogram>
+        std::chrono::nanoseconds lapInto(Histogram& histogram) {
+            auto ns = lap();
+            histogram.record(ns);
+            return ns;
+        }
+
+        void setPrecision(Precision p) { precision_ = p; }
+        Precision precision() const { return precision_; }
+
+        // raw counter ticks (cycles with rdtsc)
+        std::uint64_t elapsedCycles() const {
+            if (!started_) return 0;
+            return (running_ ? read(false) : end_) - start_;
+        }
+
+        std::chrono::nanoseconds elapsedNs() const { return toNs(elapsedCycles()); }
+
+        double elapsed() const { return elapsed(precision_); }
+        double elapsed(Precision p) const {
+            if (p == Precision::Nanoseconds) return static_cast<double>(elapsedCycles()) * source_->nsPerTick;
+            return Timer::toUnits(elapsedNs(), p);
+        }
+
+        std::string elapsedString(int maxParts = 3) const { return elapsedText(maxParts).str(); }
+
+        std::to_chars_result elapsedStringTo(char* first, char* last, int maxParts = 3) const {
+            return Timer::formatElapsedTo(first, last, elapsedNs(), precision_, maxParts);
+        }
+
+        DurationText elapsedText(int maxParts = 3) const {
+            DurationText out;
+            out.size = static_cast<size_t>(elapsedStringTo(out.data, out.data + DurationText::Capacity, maxParts).ptr - out.data);
+            out.data[out.size] = '\0';
+            return out;
+        }
+
+        const cycles::Source& source() const { return *source_; }
+
+    private:
+        const cycles::Source* source_;
+        Precision precision_;
+        bool running_ = false;
+        bool started_ = false;
+        std::uint64_t start_ = 0;
+        std::uint64_t end_ = 0;
+        std::uint64_t last_lap_ = 0;
+
+        std::uint64_t read(bool begin) const {
+            if (!source_->hardware) return cycles::steadyNow();
+            return begin ? cycles::counterBegin() : cycles::counterEnd(source_->rdtscp);
+        }
+
+        std::chrono::nanoseconds toNs(std::uint64_t ticks) const {
+            return std::chrono::nanoseconds(static_cast<long long>(static_cast<double>(ticks) * source_->nsPerTick + 0.5));
+        }
+    };
+}   // namespace Time
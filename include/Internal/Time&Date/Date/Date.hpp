@@ -3,11 +3,11 @@
 #include <ctime>
 
 namespace MF::Chrono::Date {
-    static std::time_t GetRawDate() {
+    inline std::time_t GetRawDate() {
         return std::time(nullptr);
     }
 
-    static std::tm GetLocalTm() {
+    inline std::tm GetLocalTm() {
         std::time_t t = GetRawDate();
         std::tm tm_local;
 
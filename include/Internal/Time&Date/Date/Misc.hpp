@@ -1,22 +1,15 @@
+#pragma once
+
 #include "Date.hpp"
+#include "../Format/Format.hpp"
 #include <string>
-#include <iomanip>
 
 namespace MF::Chrono::Date {
-    static std::string GetDateStr() {
-        std::time_t t = MF::Chrono::Date::GetRawDate();
-        std::tm tm_local;
-
-        #ifdef _WIN32
-            localtime_s(&tm_local, &t);
-        #else
-            localtime_r(&t, &tm_local);
-        #endif
-
-        std::ostringstream oss;
-        oss << std::setw(4) << std::setfill('0') << (tm_local.tm_year + 1900) << "-"
-            << std::setw(2) << std::setfill('0') << (tm_local.tm_mon + 1) << "-"
-            << std::setw(2) << std::setfill('0') << tm_local.tm_mday;
-        return oss.str();
+    // local "YYYY-MM-DD"
+    inline std::string GetDateStr() {
+        static const TimeFormat format("%Y-%m-%d");
+        char buffer[32];
+        auto res = format.FormatTo(buffer, buffer + sizeof(buffer), Timestamp{static_cast<std::int64_t>(GetRawDate()), 0});
+        return std::string(buffer, res.ptr);
     }
 }
\ No newline at end of file
@@ -0,0 +1,241 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <ctime>
+#include <mutex>
+
+// calendar arithmetic for MF::Chrono: dates from day counts and back without the C library
+// (Howard Hinnant's civil algorithms, proleptic Gregorian), and the local UTC offset, cached
+// between time zone transitions so local times don't need a localtime_r call each.
+namespace MF::Chrono {
+
+    enum class Zone { Local, UTC };
+
+    // a point in time: seconds since the Unix epoch and the nanoseconds within that second
+    struct Timestamp {
+        std::int64_t seconds = 0;
+        std::uint32_t nanoseconds = 0;
+
+        static Timestamp FromTimePoint(std::chrono::system_clock::time_point tp) {
+            auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(tp.time_since_epoch()).count();
+            std::int64_t s = ns / 1'000'000'000;
+            std::int64_t rest = ns % 1'000'000'000;
+            if (rest < 0) {
+                rest += 1'000'000'000;
+                --s;
+            }
+            return {s, static_cast<std::uint32_t>(rest)};
+        }
+
+        static Timestamp Now() { return FromTimePoint(std::chrono::system_clock::now()); }
+
+        std::chrono::system_clock::time_point ToTimePoint() const {
+            return std::chrono::system_clock::time_point(std::chrono::duration_cast<std::chrono::system_clock::duration>(
+                std::chrono::seconds(seconds) + std::chrono::nanoseconds(nanoseconds)));
+        }
+    };
+
+    // broken-down time; month 1-12, day 1-31, weekday 0-6 from Sunday, yearDay 1-366
+    struct CivilTime {
+        std::int64_t year = 1970;
+        unsigned month = 1;
+        unsigned day = 1;
+        unsigned hour = 0;
+        unsigned minute = 0;
+        unsigned second = 0;
+        std::uint32_t nanosecond = 0;
+        unsigned weekday = 4;
+        unsigned yearDay = 1;
+        int offsetSeconds = 0;   // local time minus UTC
+    };
+
+    struct CivilDate {
+        std::int64_t year;
+        unsigned month;
+        unsigned day;
+    };
+
+    // days since 1970-01-01 of a proleptic Gregorian date
+    constexpr std::int64_t DaysFromCivil(std::int64_t y, unsigned m, unsigned d) {
+        y -= m <= 2;
+        const std::int64_t era = (y >= 0 ? y : y - 399) / 400;
+        const unsigned yoe = static_cast<unsigned>(y - era * 400);
+        const unsigned doy = (153 * (m > 2 ? m - 3 : m + 9) + 2) / 5 + d - 1;
+        const unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+        return era * 146097 + static_cast<std::int64_t>(doe) - 719468;
+    }
+
+    constexpr CivilDate CivilFromDays(std::int64_t z) {
+        z += 719468;
+        const std::int64_t era = (z >= 0 ? z : z - 146096) / 146097;
+        const unsigned doe = static_cast<unsigned>(z - era * 146097);
+        const unsigned yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+        const unsigned doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+        const unsigned mp = (5 * doy + 2) / 153;
+        const unsigned d = doy - (153 * mp + 2) / 5 + 1;
+        const unsigned m = mp < 10 ? mp + 3 : mp - 9;
+        return {static_cast<std::int64_t>(yoe) + era * 400 + (m <= 2), m, d};
+    }
+
+    constexpr unsigned WeekdayFromDays(std::int64_t z) { return static_cast<unsigned>(z >= -4 ? (z + 4) % 7 : (z + 5) % 7 + 6); }
+
+    constexpr bool IsLeapYear(std::int64_t y) { return y % 4 == 0 && (y % 100 != 0 || y % 400 == 0); }
+
+    constexpr unsigned DaysInMonth(std::int64_t y, unsigned m) {
+        constexpr unsigned days[] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+        return m == 2 && IsLeapYear(y) ? 29 : days[(m - 1) % 12];
+    }
+
+    namespace Internal {
+        constexpr std::int64_t floorDiv(std::int64_t a, std::int64_t b) { return a / b - ((a % b != 0) && ((a < 0) != (b < 0))); }
+
+        // local time minus UTC at `t`, from the C library
+        inline int systemOffset(std::int64_t t) {
+            std::time_t tt = static_cast<std::time_t>(t);
+            std::tm local{};
+#ifdef _WIN32
+            if (localtime_s(&local, &tt) != 0) return 0;
+#else
+            if (!localtime_r(&tt, &local)) return 0;
+#endif
+            std::int64_t asUtc = DaysFromCivil(local.tm_year + 1900, static_cast<unsigned>(local.tm_mon + 1), static_cast<unsigned>(local.tm_mday)) * 86400 +
+                                 local.tm_hour * 3600 + local.tm_min * 60 + local.tm_sec;
+            return static_cast<int>(asUtc - t);
+        }
+
+        // the offset for the stretch of time around now between two transitions. readers don't lock:
+        // the window is a seqlock (odd sequence while it is rewritten); a miss takes the mutex and
+        // asks the C library
+        struct OffsetCache {
+            static constexpr std::int64_t Probe = 7 * 86400;    // transitions are further apart than this
+            static constexpr int Probes = 4;                    // a window reaches at most 4 weeks ahead
+
+            std::atomic<std::uint64_t> sequence{0};
+            std::atomic<std::int64_t> from{1};
+            std::atomic<std::int64_t> until{0};
+            std::atomic<int> offset{0};
+            std::mutex refresh;
+
+            bool tryRead(std::int64_t t, int& out) const {
+                std::uint64_t s1 = sequence.load(std::memory_order_acquire);
+                if (s1 & 1) return false;
+                std::int64_t f = from.load(std::memory_order_relaxed);
+                std::int64_t u = until.load(std::memory_order_relaxed);
+                int o = offset.load(std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (sequence.load(std::memory_order_relaxed) != s1) return false;
+                if (t < f || t >= u) return false;
+                out = o;
+                return true;
+            }
+
+            // first second of the later offset; one transition between lo and hi
+            static std::int64_t boundary(std::int64_t lo, std::int64_t hi) {
+                int before = systemOffset(lo);
+                while (hi - lo > 1) {
+                    std::int64_t mid = lo + (hi - lo) / 2;
+                    (systemOffset(mid) == before ? lo : hi) = mid;
+                }
+                return hi;
+            }
+
+            int get(std::int64_t t) {
+                int out;
+                if (tryRead(t, out)) return out;
+                // the window follows the clock; times far from now are looked up without moving it
+                std::int64_t now = static_cast<std::int64_t>(std::time(nullptr));
+                if (t < now - Probe || t > now + Probe * Probes) return systemOffset(t);
+                std::lock_guard<std::mutex> lock(refresh);
+                if (tryRead(t, out)) return out;
+                out = systemOffset(t);
+                std::int64_t start = t - Probe;
+                if (systemOffset(start) != out) start = boundary(start, t);
+                std::int64_t end = t + Probe * Probes;
+                for (int i = 1; i <= Probes; ++i) {
+                    std::int64_t probe = t + Probe * i;
+                    if (systemOffset(probe) != out) {
+                        end = boundary(probe - Probe, probe);
+                        break;
+                    }
+                }
+                sequence.fetch_add(1, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_release);
+                from.store(start, std::memory_order_relaxed);
+                until.store(end, std::memory_order_relaxed);
+                offset.store(out, std::memory_order_relaxed);
+                sequence.fetch_add(1, std::memory_order_release);
+                return out;
+            }
+
+            void reset() {
+                std::lock_guard<std::mutex> lock(refresh);
+                sequence.fetch_add(1, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_release);
+                from.store(1, std::memory_order_relaxed);
+                until.store(0, std::memory_order_relaxed);
+                sequence.fetch_add(1, std::memory_order_release);
+            }
+        };
+
+        inline OffsetCache& offsetCache() {
+            static OffsetCache cache;
+            return cache;
+        }
+    }
+
+    // local time minus UTC, in seconds, at `unixSeconds`
+    inline int UtcOffset(std::int64_t unixSeconds) { return Internal::offsetCache().get(unixSeconds); }
+
+    // forget the cached offset, after the process time zone changed (TZ, tzset)
+    inline void ResetUtcOffsetCache() {
+#ifdef _WIN32
+        _tzset();
+#else
+        tzset();
+#endif
+        Internal::offsetCache().reset();
+    }
+
+    inline CivilTime ToCivil(Timestamp ts, Zone zone = Zone::Local) {
+        CivilTime out;
+        out.offsetSeconds = zone == Zone::Local ? UtcOffset(ts.seconds) : 0;
+        std::int64_t local = ts.seconds + out.offsetSeconds;
+        std::int64_t days = Internal::floorDiv(local, 86400);
+        std::int64_t secs = local - days * 86400;
+        CivilDate date = CivilFromDays(days);
+        out.year = date.year;
+        out.month = date.month;
+        out.day = date.day;
+        out.hour = static_cast<unsigned>(secs / 3600);
+        out.minute = static_cast<unsigned>(secs / 60 % 60);
+        out.second = static_cast<unsigned>(secs % 60);
+        out.nanosecond = ts.nanoseconds;
+        out.weekday = WeekdayFromDays(days);
+        out.yearDay = static_cast<unsigned>(days - DaysFromCivil(date.year, 1, 1)) + 1;
+        return out;
+    }
+
+    inline CivilTime ToCivil(std::chrono::system_clock::time_point tp, Zone zone = Zone::Local) {
+        return ToCivil(Timestamp::FromTimePoint(tp), zone);
+    }
+
+    // the instant `c` names, reading its fields as offsetSeconds ahead of UTC (weekday and yearDay
+    // are ignored)
+    inline Timestamp FromCivil(const CivilTime& c) {
+        std::int64_t local = DaysFromCivil(c.year, c.month, c.day) * 86400 + c.hour * 3600 + c.minute * 60 + c.second;
+        return {local - c.offsetSeconds, c.nanosecond};
+    }
+
+    // the offset in effect at a local wall-clock time (seconds since the epoch, as if UTC). when the
+    // clock was set back and the time happened twice, the first; when it was set forward and the
+    // time never happened, the offset from before the change
+    inline int UtcOffsetForLocal(std::int64_t localSeconds) {
+        int before = UtcOffset(localSeconds - 86400);
+        if (UtcOffset(localSeconds - before) == before) return before;
+        int after = UtcOffset(localSeconds + 86400);
+        if (UtcOffset(localSeconds - after) == after) return after;
+        return before;
+    }
+}
@@ -0,0 +1,456 @@
+#pragma once
+
+#include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+#include "Civil.hpp"
+
+// compiled strftime-style patterns for MF::Chrono.
+//   static const MF::Chrono::TimeFormat iso("%Y-%m-%dT%H:%M:%S.%3f%:z");
+//   char buffer[64];
+//   auto res = iso.FormatTo(buffer, buffer + sizeof(buffer), MF::Chrono::Timestamp::Now());
+//   auto back = iso.Parse(std::string_view(buffer, res.ptr - buffer));
+// a pattern is split into steps once; formatting is then plain digit writes into the caller's
+// buffer (dates from Civil.hpp, no localtime_r, no allocation), and Parse reads the same pattern
+// back. specifiers:
+//   %Y year  %y year % 100  %m month  %d day  %e day, space padded  %j day of year
+//   %H hour  %I hour 1-12  %p AM/PM  %M minute  %S second
+//   %f fraction of a second, 6 digits; %3f, %9f... for 1-9 digits
+//   %z +hhmm  %:z +hh:mm  %s seconds since the epoch
+//   %a %A weekday name  %b %B month name (English)
+//   %F = %Y-%m-%d  %T = %H:%M:%S  %% a percent sign
+// anything else is copied as it is.
+namespace MF::Chrono {
+
+    namespace Internal {
+        inline constexpr std::string_view weekdayNames[] = {"Sunday", "Monday", "Tuesday", "Wednesday", "Thursday", "Friday", "Saturday"};
+        inline constexpr std::string_view monthNames[] = {"January", "February", "March", "April", "May", "June",
+                                                          "July", "August", "September", "October", "November", "December"};
+        inline constexpr char digitPairs[] =
+            "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+            "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+            "8081828384858687888990919293949596979899";
+
+        inline char* put2(char* p, unsigned v) {
+            p[0] = digitPairs[v * 2];
+            p[1] = digitPairs[v * 2 + 1];
+            return p + 2;
+        }
+
+        // `v` zero padded to `width` digits (more if it needs them)
+        inline char* putPadded(char* p, std::uint64_t v, int width) {
+            char digits[20];
+            char* end = std::to_chars(digits, digits + sizeof(digits), v).ptr;
+            for (int i = static_cast<int>(end - digits); i < width; ++i) *p++ = '0';
+            for (char* d = digits; d < end; ++d) *p++ = *d;
+            return p;
+        }
+
+        inline char lower(char c) { return c >= 'A' && c <= 'Z' ? static_cast<char>(c - 'A' + 'a') : c; }
+
+        // case-insensitive match of `name` (or its first three letters) at the start of `s`
+        inline size_t matchName(std::string_view s, std::string_view name) {
+            auto matches = [&](size_t n) {
+                if (s.size() < n) return false;
+                for (size_t i = 0; i < n; ++i) {
+                    if (lower(s[i]) != lower(name[i])) return false;
+                }
+                return true;
+            };
+            if (matches(name.size())) return name.size();
+            if (matches(3)) return 3;
+            return 0;
+        }
+
+        // up to `maxDigits` digits (at least one) from `s` at `i`
+        inline bool readNumber(std::string_view s, size_t& i, int maxDigits, std::uint64_t& out, int minDigits = 1) {
+            size_t start = i;
+            out = 0;
+            while (i < s.size() && i - start < static_cast<size_t>(maxDigits) && s[i] >= '0' && s[i] <= '9') {
+                out = out * 10 + static_cast<std::uint64_t>(s[i] - '0');
+                ++i;
+            }
+            return i - start >= static_cast<size_t>(minDigits);
+        }
+    }
+
+    class TimeFormat {
+    public:
+        explicit TimeFormat(std::string_view pattern) : pattern_(pattern) { compile(); }
+
+        const std::string& Pattern() const { return pattern_; }
+
+        // longest text this pattern can produce
+        size_t MaxSize() const { return maxSize_; }
+
+        // writes `c` into [first, last), to_chars style: ptr is the end of the text, or last with
+        // errc::value_too_large if it doesn't fit (MaxSize() always does)
+        std::to_chars_result FormatTo(char* first, char* last, const CivilTime& c) const {
+            char* p = first;
+            for (const Step& step : steps_) {
+                if (last - p < step.maxSize) return {last, std::errc::value_too_large};
+                switch (step.op) {
+                    case Op::Literal:
+                        for (std::uint16_t i = 0; i < step.length; ++i) *p++ = literals_[step.offset + i];
+                        break;
+                    case Op::Year:
+                        if (c.year < 0) *p++ = '-';
+                        p = Internal::putPadded(p, static_cast<std::uint64_t>(c.year < 0 ? -c.year : c.year), 4);
+                        break;
+                    case Op::Year2: p = Internal::put2(p, static_cast<unsigned>(((c.year % 100) + 100) % 100)); break;
+                    case Op::Month: p = Internal::put2(p, c.month); break;
+                    case Op::Day: p = Internal::put2(p, c.day); break;
+                    case Op::DaySpace:
+                        *p++ = c.day < 10 ? ' ' : static_cast<char>('0' + c.day / 10);
+                        *p++ = static_cast<char>('0' + c.day % 10);
+                        break;
+                    case Op::YearDay:
+                        *p++ = static_cast<char>('0' + c.yearDay / 100);
+                        p = Internal::put2(p, c.yearDay % 100);
+                        break;
+                    case Op::Hour: p = Internal::put2(p, c.hour); break;
+                    case Op::Hour12: p = Internal::put2(p, c.hour % 12 == 0 ? 12 : c.hour % 12); break;
+                    case Op::AmPm:
+                        *p++ = c.hour < 12 ? 'A' : 'P';
+                        *p++ = 'M';
+                        break;
+                    case Op::Minute: p = Internal::put2(p, c.minute); break;
+                    case Op::Second: p = Internal::put2(p, c.second); break;
+                    case Op::Fraction: {
+                        std::uint32_t v = c.nanosecond;
+                        for (int i = step.width; i < 9; ++i) v /= 10;
+                        for (int i = step.width - 1; i >= 0; --i) {
+                            p[i] = static_cast<char>('0' + v % 10);
+                            v /= 10;
+                        }
+                        p += step.width;
+                        break;
+                    }
+                    case Op::Offset:
+                    case Op::OffsetColon: {
+                        int offset = c.offsetSeconds;
+                        *p++ = offset < 0 ? '-' : '+';
+                        unsigned minutes = static_cast<unsigned>(offset < 0 ? -offset : offset) / 60;
+                        p = Internal::put2(p, minutes / 60 % 100);
+                        if (step.op == Op::OffsetColon) *p++ = ':';
+                        p = Internal::put2(p, minutes % 60);
+                        break;
+                    }
+                    case Op::Epoch: p = std::to_chars(p, last, FromCivil(c).seconds).ptr; break;
+                    case Op::WeekdayShort:
+                    case Op::WeekdayLong:
+                    case Op::MonthShort:
+                    case Op::MonthLong: {
+                        bool weekday = step.op == Op::WeekdayShort || step.op == Op::WeekdayLong;
+                        std::string_view name = weekday ? Internal::weekdayNames[c.weekday % 7] : Internal::monthNames[(c.month + 11) % 12];
+                        if (step.op == Op::WeekdayShort || step.op == Op::MonthShort) name = name.substr(0, 3);
+                        for (char ch : name) *p++ = ch;
+                        break;
+                    }
+                }
+            }
+            return {p, std::errc()};
+        }
+
+        std::to_chars_result FormatTo(char* first, char* last, Timestamp ts, Zone zone = Zone::Local) const {
+            return FormatTo(first, last, ToCivil(ts, zone));
+        }
+
+        std::to_chars_result FormatTo(char* first, char* last, std::chrono::system_clock::time_point tp, Zone zone = Zone::Local) const {
+            return FormatTo(first, last, ToCivil(tp, zone));
+        }
+
+        std::string Format(const CivilTime& c) const {
+            std::string out(maxSize_, '\0');
+            out.resize(static_cast<size_t>(FormatTo(out.data(), out.data() + out.size(), c).ptr - out.data()));
+            return out;
+        }
+
+        std::string Format(Timestamp ts, Zone zone = Zone::Local) const { return Format(ToCivil(ts, zone)); }
+        std::string Format(std::chrono::system_clock::time_point tp, Zone zone = Zone::Local) const { return Format(ToCivil(tp, zone)); }
+
+        // reads text written with this pattern. fields the pattern lacks default to 1970-01-01
+        // 00:00:00; weekday names are checked for form only. offsetSeconds is what %z read, or 0
+        std::optional<CivilTime> ParseCivil(std::string_view text) const {
+            Fields f;
+            if (!parseFields(text, f)) return std::nullopt;
+            return resolve(f);
+        }
+
+        // the instant the text names. without %z (or %s) the text is read as `zone` time
+        std::optional<Timestamp> Parse(std::string_view text, Zone zone = Zone::Local) const {
+            Fields f;
+            if (!parseFields(text, f)) return std::nullopt;
+            if (f.hasEpoch) return Timestamp{f.epoch, f.nanosecond};
+            auto civil = resolve(f);
+            if (!civil) return std::nullopt;
+            if (!f.hasOffset && zone == Zone::Local) {
+                civil->offsetSeconds = 0;
+                civil->offsetSeconds = UtcOffsetForLocal(FromCivil(*civil).seconds);
+            }
+            return FromCivil(*civil);
+        }
+
+    private:
+        enum class Op : std::uint8_t {
+            Literal, Year, Year2, Month, Day, DaySpace, YearDay, Hour, Hour12, AmPm, Minute, Second,
+            Fraction, Offset, OffsetColon, Epoch, WeekdayShort, WeekdayLong, MonthShort, MonthLong
+        };
+
+        struct Step {
+            Op op;
+            std::uint8_t width = 0;      // Fraction digits
+            std::uint16_t maxSize = 0;
+            std::uint16_t offset = 0;    // Literal: text in literals_
+            std::uint16_t length = 0;
+        };
+
+        struct Fields {
+            std::int64_t year = 1970;
+            unsigned month = 1, day = 1, yearDay = 0;
+            unsigned hour = 0, minute = 0, second = 0;
+            std::uint32_t nanosecond = 0;
+            int offset = 0;
+            int pm = -1;   // -1 no %p, 0 AM, 1 PM
+            bool hasEpoch = false, hasOffset = false, hasMonthDay = false, hour12 = false;
+            std::int64_t epoch = 0;
+        };
+
+        std::string pattern_;
+        std::string literals_;
+        std::vector<Step> steps_;
+        size_t maxSize_ = 0;
+
+        void add(Op op, std::uint16_t maxSize, std::uint8_t width = 0) {
+            steps_.push_back({op, width, maxSize, 0, 0});
+            maxSize_ += maxSize;
+        }
+
+        void addLiteral(std::string_view text) {
+            if (text.empty() || literals_.size() + text.size() > 0xFFFF) return;
+            if (!steps_.empty() && steps_.back().op == Op::Literal) {
+                steps_.back().length = static_cast<std::uint16_t>(steps_.back().length + text.size());
+                steps_.back().maxSize = steps_.back().length;
+            } else {
+                steps_.push_back({Op::Literal, 0, static_cast<std::uint16_t>(text.size()), static_cast<std::uint16_t>(literals_.size()),
+                                  static_cast<std::uint16_t>(text.size())});
+            }
+            literals_ += text;
+            maxSize_ += text.size();
+        }
+
+        void compile() {
+            const std::string_view s = pattern_;
+            size_t i = 0;
+            while (i < s.size()) {
+                if (s[i] != '%' || i + 1 >= s.size()) {
+                    addLiteral(s.substr(i++, 1));
+                    continue;
+                }
+                size_t start = i++;
+                int width = 0;
+                while (i < s.size() && s[i] >= '0' && s[i] <= '9' && width < 10) width = width * 10 + (s[i++] - '0');
+                bool colon = i < s.size() && s[i] == ':';
+                if (colon) ++i;
+                if (i >= s.size()) {
+                    addLiteral(s.substr(start));
+                    break;
+                }
+                char spec = s[i++];
+                if (spec == 'f' && !colon) {
+                    std::uint8_t digits = static_cast<std::uint8_t>(width >= 1 && width <= 9 ? width : 6);
+                    add(Op::Fraction, digits, digits);
+                    continue;
+                }
+                if (spec == 'z' && !width) {
+                    colon ? add(Op::OffsetColon, 6) : add(Op::Offset, 5);
+                    continue;
+                }
+                if (width || colon) {
+                    addLiteral(s.substr(start, i - start));
+                    continue;
+                }
+                switch (spec) {
+                    case 'Y': add(Op::Year, 20); break;
+                    case 'y': add(Op::Year2, 2); break;
+                    case 'm': add(Op::Month, 2); break;
+                    case 'd': add(Op::Day, 2); break;
+                    case 'e': add(Op::DaySpace, 2); break;
+                    case 'j': add(Op::YearDay, 3); break;
+                    case 'H': add(Op::Hour, 2); break;
+                    case 'I': add(Op::Hour12, 2); break;
+                    case 'p': add(Op::AmPm, 2); break;
+                    case 'M': add(Op::Minute, 2); break;
+                    case 'S': add(Op::Second, 2); break;
+                    case 's': add(Op::Epoch, 20); break;
+                    case 'a': add(Op::WeekdayShort, 3); break;
+                    case 'A': add(Op::WeekdayLong, 9); break;
+                    case 'b': add(Op::MonthShort, 3); break;
+                    case 'B': add(Op::MonthLong, 9); break;
+                    case 'F':
+                        add(Op::Year, 20);
+                        addLiteral("-");
+                        add(Op::Month, 2);
+                        addLiteral("-");
+                        add(Op::Day, 2);
+                        break;
+                    case 'T':
+                        add(Op::Hour, 2);
+                        addLiteral(":");
+                        add(Op::Minute, 2);
+                        addLiteral(":");
+                        add(Op::Second, 2);
+                        break;
+                    case '%': addLiteral("%"); break;
+                    default: addLiteral(s.substr(start, i - start)); break;
+                }
+            }
+        }
+
+        bool parseFields(std::string_view s, Fields& f) const {
+            size_t i = 0;
+            for (const Step& step : steps_) {
+                std::uint64_t v = 0;
+                switch (step.op) {
+                    case Op::Literal:
+                        for (std::uint16_t k = 0; k < step.length; ++k, ++i) {
+                            if (i >= s.size() || s[i] != literals_[step.offset + k]) return false;
+                        }
+                        break;
+                    case Op::Year: {
+                        bool negative = i < s.size() && (s[i] == '-' || s[i] == '+') && s[i++] == '-';
+                        if (!Internal::readNumber(s, i, 4, v, 4)) return false;
+                        f.year = negative ? -static_cast<std::int64_t>(v) : static_cast<std::int64_t>(v);
+                        break;
+                    }
+                    case Op::Year2:
+                        if (!Internal::readNumber(s, i, 2, v, 2)) return false;
+                        f.year = v < 69 ? 2000 + static_cast<std::int64_t>(v) : 1900 + static_cast<std::int64_t>(v);
+                        break;
+                    case Op::Month:
+                        if (!Internal::readNumber(s, i, 2, v) || v < 1 || v > 12) return false;
+                        f.month = static_cast<unsigned>(v);
+                        f.hasMonthDay = true;
+                        break;
+                    case Op::DaySpace:
+                        if (i < s.size() && s[i] == ' ') ++i;
+                        [[fallthrough]];
+                    case Op::Day:
+                        if (!Internal::readNumber(s, i, 2, v) || v < 1 || v > 31) return false;
+                        f.day = static_cast<unsigned>(v);
+                        f.hasMonthDay = true;
+                        break;
+                    case Op::YearDay:
+                        if (!Internal::readNumber(s, i, 3, v) || v < 1 || v > 366) return false;
+                        f.yearDay = static_cast<unsigned>(v);
+                        break;
+                    case Op::Hour:
+                    case Op::Hour12:
+                        if (!Internal::readNumber(s, i, 2, v) || v > (step.op == Op::Hour ? 23u : 12u) || (step.op == Op::Hour12 && v == 0)) return false;
+                        f.hour = static_cast<unsigned>(v);
+                        f.hour12 = f.hour12 || step.op == Op::Hour12;
+                        break;
+                    case Op::AmPm: {
+                        if (s.size() - i < 2 || Internal::lower(s[i + 1]) != 'm') return false;
+                        char c = Internal::lower(s[i]);
+                        if (c != 'a' && c != 'p') return false;
+                        f.pm = c == 'p';
+                        i += 2;
+                        break;
+                    }
+                    case Op::Minute:
+                        if (!Internal::readNumber(s, i, 2, v) || v > 59) return false;
+                        f.minute = static_cast<unsigned>(v);
+                        break;
+                    case Op::Second:
+                        if (!Internal::readNumber(s, i, 2, v) || v > 60) return false;
+                        f.second = static_cast<unsigned>(v);
+                        break;
+                    case Op::Fraction: {
+                        size_t start = i;
+                        if (!Internal::readNumber(s, i, 9, v)) return false;
+                        for (size_t k = i - start; k < 9; ++k) v *= 10;
+                        f.nanosecond = static_cast<std::uint32_t>(v);
+                        break;
+                    }
+                    case Op::Offset:
+                    case Op::OffsetColon: {
+                        if (i < s.size() && (s[i] == 'Z' || s[i] == 'z')) {
+                            ++i;
+                            f.offset = 0;
+                            f.hasOffset = true;
+                            break;
+                        }
+                        if (i >= s.size() || (s[i] != '+' && s[i] != '-')) return false;
+                        bool negative = s[i++] == '-';
+                        std::uint64_t hours = 0, minutes = 0;
+                        if (!Internal::readNumber(s, i, 2, hours, 2) || hours > 23) return false;
+                        if (i < s.size() && s[i] == ':') ++i;
+                        if (i < s.size() && s[i] >= '0' && s[i] <= '9' && (!Internal::readNumber(s, i, 2, minutes, 2) || minutes > 59)) return false;
+                        f.offset = static_cast<int>(hours * 3600 + minutes * 60) * (negative ? -1 : 1);
+                        f.hasOffset = true;
+                        break;
+                    }
+                    case Op::Epoch: {
+                        auto res = std::from_chars(s.data() + i, s.data() + s.size(), f.epoch);
+                        if (res.ec != std::errc()) return false;
+                        i = static_cast<size_t>(res.ptr - s.data());
+                        f.hasEpoch = true;
+                        break;
+                    }
+                    case Op::WeekdayShort:
+                    case Op::WeekdayLong: {
+                        size_t n = 0;
+                        for (auto name : Internal::weekdayNames) {
+                            if ((n = Internal::matchName(s.substr(i), name))) break;
+                        }
+                        if (!n) return false;
+                        i += n;
+                        break;
+                    }
+                    case Op::MonthShort:
+                    case Op::MonthLong: {
+                        size_t n = 0;
+                        unsigned month = 0;
+                        while (month < 12 && !(n = Internal::matchName(s.substr(i), Internal::monthNames[month]))) ++month;
+                        if (!n) return false;
+                        f.month = month + 1;
+                        f.hasMonthDay = true;
+                        i += n;
+                        break;
+                    }
+                }
+            }
+            return i == s.size();
+        }
+
+        std::optional<CivilTime> resolve(const Fields& f) const {
+            CivilTime c;
+            c.year = f.year;
+            c.month = f.month;
+            c.day = f.day;
+            if (f.yearDay && !f.hasMonthDay) {
+                if (f.yearDay > (IsLeapYear(f.year) ? 366u : 365u)) return std::nullopt;
+                CivilDate date = CivilFromDays(DaysFromCivil(f.year, 1, 1) + f.yearDay - 1);
+                c.month = date.month;
+                c.day = date.day;
+            }
+            if (c.day > DaysInMonth(c.year, c.month)) return std::nullopt;
+            c.hour = f.hour;
+            if (f.hour12 || f.pm >= 0) c.hour = f.hour % 12 + (f.pm == 1 ? 12 : 0);
+            c.minute = f.minute;
+            c.second = f.second;
+            c.nanosecond = f.nanosecond;
+            c.offsetSeconds = f.offset;
+            std::int64_t days = DaysFromCivil(c.year, c.month, c.day);
+            c.weekday = WeekdayFromDays(days);
+            c.yearDay = static_cast<unsigned>(days - DaysFromCivil(c.year, 1, 1)) + 1;
+            return c;
+        }
+    };
+}
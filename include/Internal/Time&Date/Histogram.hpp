@@ -0,0 +1,317 @@
+#pragma once
+// MFWork/Internal/Time&Date/Histogram.hpp
+// HDR latency histograms for Timer laps (header-only)
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Misc.hpp"
+
+namespace Time {
+
+// bucket layout shared by Histogram and ConcurrentHistogram (the HdrHistogram scheme): values are
+// ns, each power of two range is split into the same number of linear sub-buckets, so any value is
+// kept to `significantDigits` decimal digits from 1 ns up to `highest`. memory is fixed at
+// construction, 36 KiB of counts for the default 2 digits up to one hour.
+struct HistogramLayout {
+    std::uint64_t highest = 0;
+    int significantDigits = 2;
+    int subBucketHalfMagnitude = 0;
+    std::uint64_t subBucketCount = 0;
+    std::uint64_t subBucketHalfCount = 0;
+    std::uint64_t subBucketMask = 0;
+    size_t bucketCount = 0;
+    size_t countsLength = 0;
+
+    explicit HistogramLayout(ns_t highestTrackable = std::chrono::hours(1), int digits = 2) {
+        significantDigits = std::clamp(digits, 1, 4);
+        std::uint64_t largestSingleUnit = 2;
+        for (int i = 0; i < significantDigits; ++i) largestSingleUnit *= 10;
+        int magnitude = 0;
+        while ((std::uint64_t(1) << magnitude) < largestSingleUnit) ++magnitude;
+        subBucketHalfMagnitude = magnitude - 1;
+        subBucketCount = std::uint64_t(1) << magnitude;
+        subBucketHalfCount = subBucketCount / 2;
+        subBucketMask = subBucketCount - 1;
+        highest = std::max<std::uint64_t>(static_cast<std::uint64_t>(std::max<long long>(highestTrackable.count(), 0)), 2 * subBucketCount);
+        std::uint64_t trackable = subBucketCount;
+        bucketCount = 1;
+        while (trackable <= highest && trackable < (std::uint64_t(1) << 62)) {
+            trackable <<= 1;
+            ++bucketCount;
+        }
+        countsLength = (bucketCount + 1) * subBucketHalfCount;
+    }
+
+    // v > 0 (bucketIndex always has the sub-bucket mask bits set)
+    static int log2Floor(std::uint64_t v) {
+#if defined(__GNUC__) || defined(__clang__)
+        return 63 - __builtin_clzll(v);
+#else
+        int r = 0;
+        while (v >>= 1) ++r;
+        return r;
+#endif
+    }
+
+    int bucketIndex(std::uint64_t v) const { return log2Floor(v | subBucketMask) - subBucketHalfMagnitude; }
+
+    size_t index(std::uint64_t v) const {
+        int bucket = bucketIndex(v);
+        std::uint64_t sub = v >> bucket;
+        return (static_cast<size_t>(bucket) << subBucketHalfMagnitude) + static_cast<size_t>(sub);
+    }
+
+    // smallest value counted at `i`
+    std::uint64_t valueAt(size_t i) const {
+        long bucket = static_cast<long>(i >> subBucketHalfMagnitude) - 1;
+        std::uint64_t sub = (i & (subBucketHalfCount - 1)) + subBucketHalfCount;
+        if (bucket < 0) {
+            sub -= subBucketHalfCount;
+            bucket = 0;
+        }
+        return sub << bucket;
+    }
+
+    // largest value counted at `i`
+    std::uint64_t highestAt(size_t i) const {
+        std::uint64_t low = valueAt(i);
+        return low + (std::uint64_t(1) << bucketIndex(low)) - 1;
+    }
+
+    // values above `highest` are counted as `highest`, below zero as zero
+    std::uint64_t clamp(long long ns) const {
+        if (ns <= 0) return 0;
+        return std::min(static_cast<std::uint64_t>(ns), highest);
+    }
+
+    bool sameAs(const HistogramLayout& o) const { return highest == o.highest && significantDigits == o.significantDigits; }
+};
+
+// single-writer histogram; also what ConcurrentHistogram::snapshot returns. record is one
+// increment, queries walk the counts once.
+class Histogram {
+public:
+    explicit Histogram(ns_t highestTrackable = std::chrono::hours(1), int significantDigits = 2)
+        : layout_(highestTrackable, significantDigits), counts_(layout_.countsLength, 0) {}
+
+    explicit Histogram(const HistogramLayout& layout) : layout_(layout), counts_(layout_.countsLength, 0) {}
+
+    void record(ns_t ns, std::uint64_t count = 1) { recordValue(layout_.clamp(ns.count()), count); }
+
+    void recordValue(std::uint64_t v, std::uint64_t count = 1) {
+        if (v > layout_.highest) v = layout_.highest;
+        counts_[layout_.index(v)] += count;
+        total_ += count;
+        sum_ += static_cast<long double>(v) * static_cast<long double>(count);
+        if (v < min_) min_ = v;
+        if (v > max_) max_ = v;
+    }
+
+    // adds another histogram's counts; layouts may differ (values are then re-bucketed)
+    void merge(const Histogram& other) {
+        if (!other.total_) return;
+        if (layout_.sameAs(other.layout_)) {
+            for (size_t i = 0; i < counts_.size(); ++i) counts_[i] += other.counts_[i];
+            total_ += other.total_;
+            sum_ += other.sum_;
+            min_ = std::min(min_, other.min_);
+            max_ = std::max(max_, other.max_);
+            return;
+        }
+        for (size_t i = 0; i < other.counts_.size(); ++i) {
+            if (other.counts_[i]) recordValue(other.layout_.valueAt(i), other.counts_[i]);
+        }
+        min_ = std::min(min_, std::min(other.min_, layout_.highest));
+        max_ = std::max(max_, std::min(other.max_, layout_.highest));
+    }
+
+    void reset() {
+        std::fill(counts_.begin(), counts_.end(), 0);
+        total_ = 0;
+        sum_ = 0.0L;
+        min_ = UINT64_MAX;
+        max_ = 0;
+    }
+
+    std::uint64_t count() const { return total_; }
+    bool empty() const { return total_ == 0; }
+
+    ns_t min() const { return ns_t(total_ ? static_cast<long long>(min_) : 0); }
+    ns_t max() const { return ns_t(static_cast<long long>(max_)); }
+    ns_t mean() const { return ns_t(total_ ? static_cast<long long>(sum_ / static_cast<long double>(total_) + 0.5L) : 0); }
+
+    // value at or below which `p` percent of the recorded values fall (0..100). exact to the
+    // layout's precision, never above max()
+    ns_t percentile(double p) const {
+        if (!total_) return ns_t::zero();
+        p = std::clamp(p, 0.0, 100.0);
+        std::uint64_t target = static_cast<std::uint64_t>(p / 100.0 * static_cast<double>(total_) + 0.5);
+        if (target < 1) target = 1;
+        std::uint64_t seen = 0;
+        for (size_t i = 0; i < counts_.size(); ++i) {
+            seen += counts_[i];
+            if (seen >= target) {
+                std::uint64_t v = std::min(layout_.highestAt(i), max_);
+                return ns_t(static_cast<long long>(std::max(v, min_)));
+            }
+        }
+        return max();
+    }
+
+    ns_t p50() const { return percentile(50.0); }
+    ns_t p90() const { return percentile(90.0); }
+    ns_t p99() const { return percentile(99.0); }
+    ns_t p999() const { return percentile(99.9); }
+
+    // "n=1200 p50=12.5 us p90=... p99=... p999=... max=..."
+    std::string summary() const {
+        std::string out = "n=" + std::to_string(total_);
+        const std::pair<const char*, ns_t> parts[] = {{" p50=", p50()}, {" p90=", p90()}, {" p99=", p99()}, {" p999=", p999()}, {" max=", max()}};
+        for (const auto& [label, ns] : parts) {
+            out += label;
+            out += formatLatency(ns);
+        }
+        return out;
+    }
+
+    // ns below 1 us, then us, then ms, then the multi-unit duration format
+    static std::string formatLatency(ns_t ns) {
+        long long n = ns.count();
+        Timer::Precision p = n < 1000 ? Timer::Precision::Nanoseconds
+                           : n < 1000000 ? Timer::Precision::Microseconds
+                           : n < 1000000000 ? Timer::Precision::Milliseconds
+                           : Timer::Precision::Seconds;
+        DurationText text;
+        auto res = Timer::formatElapsedTo(text.data, text.data + DurationText::Capacity, ns, p);
+        return std::string(text.data, res.ptr);
+    }
+
+    const HistogramLayout& layout() const { return layout_; }
+    const std::vector<std::uint64_t>& counts() const { return counts_; }
+
+private:
+    friend class ConcurrentHistogram;
+
+    HistogramLayout layout_;
+    std::vector<std::uint64_t> counts_;
+    std::uint64_t total_ = 0;
+    long double sum_ = 0.0L;
+    std::uint64_t min_ = UINT64_MAX;
+    std::uint64_t max_ = 0;
+};
+
+// histogram any number of threads record into without locks. each thread is assigned one of a
+// fixed set of stripes (its own counters, padded apart), so concurrent records rarely touch the
+// same cache line; snapshot() merges the stripes into a Histogram while recording continues.
+class ConcurrentHistogram {
+public:
+    explicit ConcurrentHistogram(ns_t highestTrackable = std::chrono::hours(1), int significantDigits = 2,
+                                 unsigned stripes = 0)
+        : layout_(highestTrackable, significantDigits) {
+        if (!stripes) stripes = std::clamp(std::thread::hardware_concurrency(), 1u, 64u);
+        stripeCount_ = stripes;
+        stripes_ = std::make_unique<Stripe[]>(stripes);
+        for (unsigned s = 0; s < stripes; ++s) stripes_[s].counts = std::make_unique<std::atomic<std::uint64_t>[]>(layout_.countsLength);
+    }
+
+    ConcurrentHistogram(const ConcurrentHistogram&) = delete;
+    ConcurrentHistogram& operator=(const ConcurrentHistogram&) = delete;
+
+    void record(ns_t ns, std::uint64_t count = 1) {
+        std::uint64_t v = layout_.clamp(ns.count());
+        Stripe& s = stripes_[threadSlot() % stripeCount_];
+        s.counts[layout_.index(v)].fetch_add(count, std::memory_order_relaxed);
+        s.total.fetch_add(count, std::memory_order_relaxed);
+        s.sum.fetch_add(v * count, std::memory_order_relaxed);
+        std::uint64_t seen = s.min.load(std::memory_order_relaxed);
+        while (v < seen && !s.min.compare_exchange_weak(seen, v, std::memory_order_relaxed)) {}
+        seen = s.max.load(std::memory_order_relaxed);
+        while (v > seen && !s.max.compare_exchange_weak(seen, v, std::memory_order_relaxed)) {}
+    }
+
+    // counts so far, merged over stripes. records racing with the snapshot land in this one or the next
+    Histogram snapshot() const {
+        Histogram out(layout_);
+        snapshotInto(out);
+        return out;
+    }
+
+    // replaces `out` (which must have this layout, e.g. from an earlier snapshot) without allocating
+    void snapshotInto(Histogram& out) const {
+        if (!out.layout_.sameAs(layout_)) out = Histogram(layout_);
+        out.reset();
+        for (unsigned s = 0; s < stripeCount_; ++s) addStripe(stripes_[s], out);
+    }
+
+    // counts since the previous drain; resets as it reads, so intervals don't overlap
+    Histogram drain() {
+        Histogram out(layout_);
+        for (unsigned s = 0; s < stripeCount_; ++s) {
+            Stripe& stripe = stripes_[s];
+            std::uint64_t total = 0;
+            for (size_t i = 0; i < layout_.countsLength; ++i) {
+                std::uint64_t c = stripe.counts[i].exchange(0, std::memory_order_relaxed);
+                out.counts_[i] += c;
+                total += c;
+            }
+            stripe.total.fetch_sub(total, std::memory_order_relaxed);
+            out.total_ += total;
+            out.sum_ += static_cast<long double>(stripe.sum.exchange(0, std::memory_order_relaxed));
+            out.min_ = std::min(out.min_, stripe.min.exchange(UINT64_MAX, std::memory_order_relaxed));
+            out.max_ = std::max(out.max_, stripe.max.exchange(0, std::memory_order_relaxed));
+        }
+        return out;
+    }
+
+    void reset() { drain(); }
+
+    std::uint64_t count() const {
+        std::uint64_t total = 0;
+        for (unsigned s = 0; s < stripeCount_; ++s) total += stripes_[s].total.load(std::memory_order_relaxed);
+        return total;
+    }
+
+    const HistogramLayout& layout() const { return layout_; }
+
+private:
+    struct alignas(64) Stripe {
+        std::unique_ptr<std::atomic<std::uint64_t>[]> counts;
+        std::atomic<std::uint64_t> total{0};
+        std::atomic<std::uint64_t> sum{0};
+        std::atomic<std::uint64_t> min{UINT64_MAX};
+        std::atomic<std::uint64_t> max{0};
+    };
+
+    static unsigned threadSlot() {
+        static std::atomic<unsigned> next{0};
+        thread_local unsigned slot = next.fetch_add(1, std::memory_order_relaxed);
+        return slot;
+    }
+
+    void addStripe(const Stripe& stripe, Histogram& out) const {
+        std::uint64_t total = 0;
+        for (size_t i = 0; i < layout_.countsLength; ++i) {
+            std::uint64_t c = stripe.counts[i].load(std::memory_order_relaxed);
+            out.counts_[i] += c;
+            total += c;
+        }
+        // total, min and max are taken from the counts read, not the racing stripe totals
+        out.total_ += total;
+        out.sum_ += static_cast<long double>(stripe.sum.load(std::memory_order_relaxed));
+        if (total) {
+            out.min_ = std::min(out.min_, stripe.min.load(std::memory_order_relaxed));
+            out.max_ = std::max(out.max_, stripe.max.load(std::memory_order_relaxed));
+        }
+    }
+
+    HistogramLayout layout_;
+    unsigned stripeCount_ = 1;
+    std::unique_ptr<Stripe[]> stripes_;
+};
+}   // namespace Time
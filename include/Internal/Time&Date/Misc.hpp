@@ -2,8 +2,16 @@
 // MFWork/Internal/Time&Date/Timer.hpp
 // advanced timer + duration parser/formatter (header-only)
 
+#include <array>
+#include <cerrno>
+#include <charconv>
 #include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
 #include <string>
+#include <string_view>
 #include <optional>
 #include <unordered_map>
 #include <vector>
@@ -74,47 +82,137 @@ static inline std::unordered_map<std::string,int> unit_rank() {
     return r;
 }
 
+// table-driven lookups for parseDuration, no allocation. unit index i matches unit_table_desc[i]
+namespace detail {
+    inline constexpr long double unit_ns[] = {
+        365.0L * 24.0L * 60.0L * 60.0L * 1000000000.0L, // y
+        30.0L  * 24.0L * 60.0L * 60.0L * 1000000000.0L, // mo
+        7.0L   * 24.0L * 60.0L * 60.0L * 1000000000.0L, // w
+        24.0L  * 60.0L * 60.0L * 1000000000.0L,         // d
+        60.0L  * 60.0L * 1000000000.0L,                 // h
+        60.0L  * 1000000000.0L,                         // m
+        1000000000.0L,                                  // s
+        1000000.0L                                      // ms
+    };
+
+    struct UnitAlias { std::string_view name; int unit; };
+
+    // same spellings as unit_aliases
+    inline constexpr UnitAlias unit_alias_table[] = {
+        {"y", 0}, {"yr", 0}, {"year", 0}, {"years", 0},
+        {"mo", 1}, {"mon", 1}, {"month", 1}, {"months", 1},
+        {"w", 2}, {"week", 2}, {"weeks", 2},
+        {"d", 3}, {"day", 3}, {"days", 3},
+        {"h", 4}, {"hr", 4}, {"hour", 4}, {"hours", 4},
+        {"m", 5}, {"min", 5}, {"mins", 5}, {"minute", 5}, {"minutes", 5},
+        {"s", 6}, {"sec", 6}, {"secs", 6}, {"second", 6}, {"seconds", 6},
+        {"ms", 7}, {"millisecond", 7}, {"milliseconds", 7}
+    };
+    inline constexpr size_t max_unit_alias = 12; // "milliseconds"
+
+    // unit index for lowercase letters, -1 if unknown
+    constexpr int findUnit(std::string_view lower) {
+        for (const auto& a : unit_alias_table) {
+            if (a.name.size() == lower.size() && a.name[0] == lower[0] && a.name == lower) return a.unit;
+        }
+        return -1;
+    }
+
+    // the "C" locale classes parseDuration always went by, without the locale lookups
+    constexpr bool isSpace(char c) { return c == ' ' || (c >= '\t' && c <= '\r'); }
+    constexpr bool isDigit(char c) { return c >= '0' && c <= '9'; }
+    constexpr bool isAlpha(char c) { return (c | 0x20) >= 'a' && (c | 0x20) <= 'z'; }
+    constexpr char toLower(char c) { return c >= 'A' && c <= 'Z' ? static_cast<char>(c + 32) : c; }
+
+    // powers of ten that are exact in long double: 10^k = 2^k * 5^k, exact while 5^k fits the mantissa
+    inline constexpr int exact_pow10_max = std::numeric_limits<long double>::digits >= 64 ? 27 : 22;
+    constexpr long double pow10(int k) {
+        long double r = 1.0L;
+        while (k-- > 0) r *= 10.0L;
+        return r;
+    }
+
+    // the digits-and-dots run parseDuration reads as a number, converted to the same long double
+    // std::stold gives. up to 19 significant digits it's one exact integer over one exact power of
+    // ten, a single correctly rounded division like strtold's own result. longer runs go to
+    // std::from_chars, or to strtold where the library has no floating-point from_chars.
+    inline bool parseDurationNumber(std::string_view text, long double& out) {
+        std::uint64_t digits = 0;
+        int significant = 0, fraction = 0;
+        bool seenDot = false;
+        for (char c : text) {
+            if (c == '.') {
+                seenDot = true;
+                continue;
+            }
+            if (seenDot) ++fraction;
+            if (significant || c != '0') {
+                digits = digits * 10 + static_cast<unsigned>(c - '0');
+                ++significant;
+            }
+            if (significant > 19) break;
+        }
+        constexpr std::uint64_t exact_limit = std::numeric_limits<long double>::digits >= 64
+            ? std::numeric_limits<std::uint64_t>::max() : (std::uint64_t(1) << std::numeric_limits<long double>::digits);
+        if (significant <= 19 && fraction <= exact_pow10_max && digits <= exact_limit) {
+            static constexpr auto powers = [] {
+                std::array<long double, exact_pow10_max + 1> p{};
+                for (int k = 0; k <= exact_pow10_max; ++k) p[k] = pow10(k);
+                return p;
+            }();
+            out = fraction ? static_cast<long double>(digits) / powers[fraction] : static_cast<long double>(digits);
+            return true;
+        }
+
+        // std::stold fails on overflow and underflow (ERANGE), so does this
+#if defined(__cpp_lib_to_chars)
+        auto res = std::from_chars(text.data(), text.data() + text.size(), out);
+        return res.ec == std::errc() && res.ptr == text.data() + text.size();
+#else
+        char buffer[128];
+        if (text.size() >= sizeof(buffer)) {
+            try {
+                out = std::stold(std::string(text));
+            } catch (...) { return false; }
+            return true;
+        }
+        std::memcpy(buffer, text.data(), text.size());
+        buffer[text.size()] = '\0';
+        errno = 0;
+        char* end = nullptr;
+        out = std::strtold(buffer, &end);
+        return end != buffer && errno != ERANGE;
+#endif
+    }
+}
+
 // parse duration string -> optional nanoseconds
 // returns std::nullopt on invalid format or rule violation
-static inline std::optional<ns_t> parseDuration(const std::string& raw) {
-    if (raw.empty()) return std::nullopt;
-    // normalize separators: replace commas with spaces
-    std::string s;
-    s.reserve(raw.size());
-    for (char c : raw) {
-        if (c == ',') s.push_back(' ');
-        else s.push_back(c);
-    }
+//  - tokens are [number][unit], e.g. "1h 2m", "1.5h", "237 ms", "1h2m3s237ms"; commas count as spaces
+//  - units must not grow from one token to the next
+//  - a zero token can't be followed by a non-zero one ("0h 5m" is rejected)
+// single pass over the text, nothing is allocated
+static inline std::optional<ns_t> parseDuration(std::string_view s) {
+    if (s.empty()) return std::nullopt;
+    auto space = [](char c) { return c == ',' || detail::isSpace(c); };
 
-    // tokenization: extract sequences of [number][unit]
-    // allow formats like: "1h 2m", "1.5h", "237 ms", "1h2m3s237ms"
     size_t i = 0;
     const size_t n = s.size();
+    int prevUnit = -1;
+    bool sawZero = false, sawToken = false;
+    long double total_ns_ld = 0.0L;
 
-    // prepare unit lookup
-    std::unordered_map<std::string,long double> unitToNs;
-    for (auto &p : unit_table_desc) unitToNs[p.first] = p.second;
-    auto aliases = unit_aliases; // copy
-    auto ranks = unit_rank();
-
-    // collected tokens in order
-    struct Token { std::string unit; long double value; bool explicitProvided; };
-    std::vector<Token> tokens;
-
-    // parsing loop: read number, then unit letters
     while (i < n) {
-        // skip spaces
-        while (i < n && std::isspace(static_cast<unsigned char>(s[i]))) ++i;
+        while (i < n && space(s[i])) ++i;
         if (i >= n) break;
 
-        // read number (signed? we don't accept negative)
+        // number: digits with at most one dot (no sign, durations aren't negative)
         size_t startNum = i;
         bool hasDigits = false;
         bool sawDot = false;
-        // optional sign not allowed (no negative)
-        while (i < n && (std::isdigit(static_cast<unsigned char>(s[i])) || s[i] == '.')) {
+        while (i < n && (detail::isDigit(s[i]) || s[i] == '.')) {
             if (s[i] == '.') {
-                if (sawDot) break; // second dot -> stop number
+                if (sawDot) break;
                 sawDot = true;
             } else {
                 hasDigits = true;
@@ -122,78 +220,27 @@ static inline std::optional<ns_t> parseDuration(const std::string& raw) {
             ++i;
         }
         if (!hasDigits) return std::nullopt;
-        std::string numStr = s.substr(startNum, i - startNum);
-        // parse double
         long double val = 0.0L;
-        try {
-            val = std::stold(numStr);
-        } catch (...) { return std::nullopt; }
-
-        // skip spaces between number and unit (allow "237 ms")
-        while (i < n && std::isspace(static_cast<unsigned char>(s[i]))) ++i;
-        if (i >= n) {
-            // number with no unit -> interpret as milliseconds? no, invalid
-            return std::nullopt;
-        }
+        if (!detail::parseDurationNumber(s.substr(startNum, i - startNum), val)) return std::nullopt;
 
-        // read unit letters (alpha)
+        // "237 ms" is fine, a number without unit isn't
+        while (i < n && space(s[i])) ++i;
         size_t startUnit = i;
-        while (i < n && std::isalpha(static_cast<unsigned char>(s[i]))) ++i;
-        if (startUnit == i) return std::nullopt; // no unit letters
-        std::string u = s.substr(startUnit, i - startUnit);
-        u = toLower(u);
-
-        // normalize alias
-        auto itAlias = aliases.find(u);
-        if (itAlias == aliases.end()) {
-            // acceptance: treat single 'm' as minute; 'mo' is month; ensure user uses 'mo' for months
-            return std::nullopt;
-        }
-        std::string canon = itAlias->second;
-
-        // push token
-        tokens.push_back({canon, val, true});
-
-        // continue
-    } // end parse loop
-
-    if (tokens.empty()) return std::nullopt;
-
-    // check ordering: tokens must be in descending order of unit rank
-    auto ranksMap = unit_rank();
-    int prevRank = INT_MAX;
-    for (const auto &t : tokens) {
-        int r = ranksMap.count(t.unit) ? ranksMap[t.unit] : -1;
-        if (r == -1) return std::nullopt;
-        if (r > prevRank) {
-            // this token is a larger unit than previous (out of order)
-            return std::nullopt;
-        }
-        prevRank = r;
-    }
-
-    // rule: reject if any explicitly provided higher-order unit has value == 0 while
-    // a smaller (later) unit was provided with value > 0.
-    // find, for each token with value==0, whether any later token has >0
-    for (size_t idx = 0; idx < tokens.size(); ++idx) {
-        if (tokens[idx].value == 0.0L) {
-            for (size_t j = idx + 1; j < tokens.size(); ++j) {
-                if (tokens[j].value > 0.0L) {
-                    // invalid per strict rule
-                    return std::nullopt;
-                }
-            }
-        }
-    }
-
-    // accumulate total ns
-    long double total_ns_ld = 0.0L;
-    for (const auto &t : tokens) {
-        auto it = unitToNs.find(t.unit);
-        if (it == unitToNs.end()) return std::nullopt;
-        total_ns_ld += t.value * it->second;
+        while (i < n && detail::isAlpha(s[i])) ++i;
+        if (startUnit == i || i - startUnit > detail::max_unit_alias) return std::nullopt;
+        char lower[detail::max_unit_alias];
+        for (size_t k = startUnit; k < i; ++k) lower[k - startUnit] = detail::toLower(s[k]);
+        int unit = detail::findUnit(std::string_view(lower, i - startUnit));
+        if (unit < 0 || unit < prevUnit) return std::nullopt;
+        prevUnit = unit;
+
+        if (val == 0.0L) sawZero = true;
+        else if (val > 0.0L && sawZero) return std::nullopt;
+        total_ns_ld += val * detail::unit_ns[unit];
+        sawToken = true;
     }
 
+    if (!sawToken) return std::nullopt;
     if (!std::isfinite(total_ns_ld)) return std::nullopt;
     if (total_ns_ld < 0.0L) return std::nullopt;
 
@@ -205,74 +252,112 @@ static inline std::optional<ns_t> parseDuration(const std::string& raw) {
     return ns_t(total_ns);
 }
 
-// format duration (nanoseconds) into readable string
-// respects descending units; drops zero units unless showZeros==true
-static inline std::string formatDuration(ns_t ns, const FormatOptions& opts = {}) {
-    long long total_ns = ns.count();
-    if (total_ns < 0) total_ns = 0;
+static inline std::optional<ns_t> parseDuration(const std::string& raw) { return parseDuration(std::string_view(raw)); }
+static inline std::optional<ns_t> parseDuration(const char* raw) { return parseDuration(std::string_view(raw ? raw : "")); }
 
-    struct UnitOut { std::string name; long long qty; };
+// fixed-capacity text from the buffer formatters below, holds any formatted duration.
+// null-terminated, for printf-style loggers
+struct DurationText {
+    static constexpr size_t Capacity = 64;
+    char data[Capacity + 1];
+    size_t size = 0;
 
-    std::vector<UnitOut> parts;
-    long long rest_ns = total_ns;
+    const char* c_str() const { return data; }
+    std::string_view view() const { return std::string_view(data, size); }
+    operator std::string_view() const { return view(); }
+    std::string str() const { return std::string(data, size); }
+};
 
-    for (const auto &p : unit_table_desc) {
-        const std::string &unit = p.first;
-        long double unit_ns_ld = p.second;
-        long long unit_ns = (long long)std::llround(unit_ns_ld);
-        if (unit_ns <= 0) continue;
-        long long qty = (long long)(rest_ns / unit_ns);
-        if (qty > 0) {
-            parts.push_back({unit, qty});
-            rest_ns -= qty * unit_ns;
-        } else {
-            if (opts.showZeros) parts.push_back({unit, 0});
-        }
+namespace detail {
+    // unit_table_desc as integers
+    inline constexpr std::string_view unit_names[] = {"y", "mo", "w", "d", "h", "m", "s", "ms"};
+    inline constexpr long long unit_ns_int[] = {
+        365LL * 24 * 60 * 60 * 1000000000, 30LL * 24 * 60 * 60 * 1000000000, 7LL * 24 * 60 * 60 * 1000000000,
+        24LL * 60 * 60 * 1000000000, 60LL * 60 * 1000000000, 60LL * 1000000000, 1000000000LL, 1000000LL
+    };
+
+    // append helpers for the formatters: nullptr once the text doesn't fit
+    inline char* put(char* p, char* last, std::string_view s) {
+        if (!p || last - p < static_cast<std::ptrdiff_t>(s.size())) return nullptr;
+        std::memcpy(p, s.data(), s.size());
+        return p + s.size();
+    }
+    inline char* put(char* p, char* last, long long value) {
+        if (!p) return nullptr;
+        auto res = std::to_chars(p, last, value);
+        return res.ec == std::errc() ? res.ptr : nullptr;
     }
+    template <typename T>
+    inline char* putFixed3(char* p, char* last, T value) {
+        if (!p) return nullptr;
+        auto res = std::to_chars(p, last, value, std::chars_format::fixed, 3);
+        return res.ec == std::errc() ? res.ptr : nullptr;
+    }
+
+    inline std::to_chars_result done(char* p, char* last) {
+        if (!p) return {last, std::errc::value_too_large};
+        return {p, std::errc()};
+    }
+}
+
+// formatDuration into [first, last), like std::to_chars: returns the end of the text, or
+// {last, errc::value_too_large} when it doesn't fit (DurationText::Capacity always does)
+static inline std::to_chars_result formatDurationTo(char* first, char* last, ns_t ns, const FormatOptions& opts = {}) {
+    long long total_ns = ns.count();
+    if (total_ns < 0) total_ns = 0;
 
-    // If nothing and showZeros false, return "0ms"
-    if (parts.empty()) {
-        if (opts.showZeros) {
-            std::ostringstream os; os << "0ms"; return os.str();
-        } else {
-            return std::string("0ms");
+    // units to show, largest first; zero ones only with showZeros
+    int units[std::size(detail::unit_ns_int)];
+    long long qty[std::size(detail::unit_ns_int)];
+    int parts = 0;
+    long long rest_ns = total_ns;
+    for (int u = 0; u < static_cast<int>(std::size(detail::unit_ns_int)); ++u) {
+        long long q = rest_ns / detail::unit_ns_int[u];
+        if (q > 0) {
+            rest_ns -= q * detail::unit_ns_int[u];
+        } else if (!opts.showZeros) {
+            continue;
         }
+        units[parts] = u;
+        qty[parts++] = q;
     }
 
-    // build output respecting maxUnits
-    std::ostringstream os;
-    int shown = 0;
-    int maxu = opts.maxUnits <= 0 ? (int)parts.size() : std::min((int)parts.size(), opts.maxUnits);
+    if (parts == 0) return detail::done(detail::put(first, last, "0ms"), last);
 
-    for (size_t i = 0; i < parts.size() && shown < maxu; ++i) {
-        if (!opts.showZeros && parts[i].qty == 0) continue;
-        if (shown) os << " ";
-        os << parts[i].qty << parts[i].name;
-        ++shown;
+    // a single unit shows the whole duration in it, with 3 decimals
+    if (opts.maxUnits == 1) {
+        long double fullVal = (long double)total_ns / (long double)detail::unit_ns_int[units[0]];
+        char* p = detail::putFixed3(first, last, fullVal);
+        return detail::done(detail::put(p, last, detail::unit_names[units[0]]), last);
     }
 
-    // if we limited to 1 unit and there is remainder, show decimal fraction for that unit
-    if (opts.maxUnits == 1 && !parts.empty()) {
-        // compute largest unit (first non-zero)
-        const auto &p = parts.front();
-        long double unit_ns_ld = 0.0L;
-        for (auto &ut : unit_table_desc) if (ut.first == p.name) unit_ns_ld = ut.second;
-        if (unit_ns_ld > 0.0L) {
-            long double fullVal = (long double)total_ns / unit_ns_ld;
-            // show with 3 decimal places if fractional
-            std::ostringstream os2;
-            os2 << std::fixed << std::setprecision(3);
-            os2 << fullVal << p.name;
-            return os2.str();
-        }
+    int maxu = opts.maxUnits <= 0 ? parts : std::min(parts, opts.maxUnits);
+    char* p = first;
+    for (int i = 0; i < maxu; ++i) {
+        if (i) p = detail::put(p, last, " ");
+        p = detail::put(p, last, qty[i]);
+        p = detail::put(p, last, detail::unit_names[units[i]]);
     }
+    return detail::done(p, last);
+}
 
-    return os.str();
+static inline DurationText formatDurationText(ns_t ns, const FormatOptions& opts = {}) {
+    DurationText out;
+    out.size = static_cast<size_t>(formatDurationTo(out.data, out.data + DurationText::Capacity, ns, opts).ptr - out.data);
+    out.data[out.size] = '\0';
+    return out;
+}
+
+// format duration (nanoseconds) into readable string
+// respects descending units; drops zero units unless showZeros==true
+static inline std::string formatDuration(ns_t ns, const FormatOptions& opts = {}) {
+    return formatDurationText(ns, opts).str();
 }
 
 // Timer class: stopwatch style
     class Timer {
     public:
+        // new units go last, so the values callers may have stored keep their meaning
         enum class Precision {
             Milliseconds,
             Seconds,
@@ -281,14 +366,16 @@ static inline std::string formatDuration(ns_t ns, const FormatOptions& opts = {}
             Days,
             Weeks,
             Months,
-            Years
+            Years,
+            Nanoseconds,
+            Microseconds
         };
 
         // ctor: direct precision
         explicit Timer(Precision p = Precision::Milliseconds)
             : precision_(p), running_(false), threshold_(ns_t::zero()) {}
 
-        // ctor: token like "ms", "s", "m", "h", "d", "w", "mo", "y"
+        // ctor: token like "ns", "us", "ms", "s", "m", "h", "d", "w", "mo", "y"
         explicit Timer(const std::string& unitToken)
             : precision_(parsePrecisionToken(unitToken)), running_(false), threshold_(ns_t::zero()) {}
 
@@ -324,6 +411,15 @@ static inline std::string formatDuration(ns_t ns, const FormatOptions& opts = {}
             return ns;
         }
 
+        // lap() recorded into a histogram (Time::Histogram, Time::ConcurrentHistogram in Histogram.hpp,
+        // or anything with record(nanoseconds)); returns the lap as well
+        template <typename Histogram>
+        std::chrono::nanoseconds lapInto(Histogram& histogram) {
+            auto ns = lap();
+            histogram.record(ns);
+            return ns;
+        }
+
         // threshold helpers
         void setThreshold(std::chrono::nanoseconds ns) { threshold_ = ns; }
         void setThreshold(const std::string& spec) {
@@ -347,26 +443,62 @@ static inline std::string formatDuration(ns_t ns, const FormatOptions& opts = {}
         double elapsed() const { return toUnits(elapsedNs(), precision_); }
         double elapsed(Precision p) const { return toUnits(elapsedNs(), p); }
 
-        // string: if timer was constructed with "ms" precision, force fractional ms output (e.g. "0.341 ms")
-        // otherwise fallback to the global formatDuration (multi-unit) using maxParts
+        // string: "ns" precision gives whole nanoseconds ("341 ns"), "us" and "ms" fractional
+        // microseconds/milliseconds ("12.5 us", "0.341 ms"); otherwise fallback to the global
+        // formatDuration (multi-unit) using maxParts
         std::string elapsedString(int maxParts = 3) const {
-            if (precision_ == Precision::Milliseconds) {
-                long double ms = (long double)elapsedNs().count() / NS_IN_MS;
-                std::ostringstream os;
-                // show up to 3 decimal places, but trim trailing zeros
-                os << std::fixed << std::setprecision(3) << (double)ms;
-                std::string s = os.str();
-                // trim trailing zeros and dot
-                while (!s.empty() && s.back() == '0') s.pop_back();
-                if (!s.empty() && s.back() == '.') s.pop_back();
-                return s + " ms";
-            } else {
-                // use global formatter you already have (formatDuration)
+            return elapsedText(maxParts).str();
+        }
+
+        // elapsedString into [first, last), to_chars style (see formatDurationTo)
+        std::to_chars_result elapsedStringTo(char* first, char* last, int maxParts = 3) const {
+            return formatElapsedTo(first, last, elapsedNs(), precision_, maxParts);
+        }
+
+        DurationText elapsedText(int maxParts = 3) const {
+            DurationText out;
+            out.size = static_cast<size_t>(elapsedStringTo(out.data, out.data + DurationText::Capacity, maxParts).ptr - out.data);
+            out.data[out.size] = '\0';
+            return out;
+        }
+
+        // convert ns -> chosen unit (double, fractional)
+        static double toUnits(std::chrono::nanoseconds ns, Precision p) {
+            const long double n = (long double)ns.count();
+            switch (p) {
+                case Precision::Nanoseconds:  return (double)n;
+                case Precision::Microseconds: return (double)(n / NS_IN_US);
+                case Precision::Milliseconds: return (double)(n / NS_IN_MS);
+                case Precision::Seconds:      return (double)(n / NS_IN_S);
+                case Precision::Minutes:      return (double)(n / MIN_NS);
+                case Precision::Hours:        return (double)(n / HOUR_NS);
+                case Precision::Days:         return (double)(n / DAY_NS);
+                case Precision::Weeks:        return (double)(n / WEEK_NS);
+                case Precision::Months:       return (double)(n / MONTH_NS);
+                case Precision::Years:        return (double)(n / YEAR_NS);
+            }
+            return 0.0;
+        }
+
+        // the elapsedString format for any duration, shared with CycleTimer
+        static std::to_chars_result formatElapsedTo(char* first, char* last, ns_t ns, Precision p, int maxParts = 3) {
+            if (p == Precision::Nanoseconds) {
+                return detail::done(detail::put(detail::put(first, last, (long long)ns.count()), last, " ns"), last);
+            }
+            if (p != Precision::Milliseconds && p != Precision::Microseconds) {
                 FormatOptions fo;
                 fo.maxUnits = maxParts;
                 fo.showZeros = false;
-                return formatDuration(elapsedNs(), fo);
+                return formatDurationTo(first, last, ns, fo);
+            }
+            // up to 3 decimal places, trailing zeros and dot trimmed
+            long double v = (long double)ns.count() / (p == Precision::Milliseconds ? NS_IN_MS : NS_IN_US);
+            char* end = detail::putFixed3(first, last, (double)v);
+            if (end) {
+                while (end[-1] == '0') --end;
+                if (end[-1] == '.') --end;
             }
+            return detail::done(detail::put(end, last, p == Precision::Milliseconds ? " ms" : " us"), last);
         }
 
     private:
@@ -392,6 +524,8 @@ static inline std::string formatDuration(ns_t ns, const FormatOptions& opts = {}
         static Precision parsePrecisionToken(const std::string& tok) {
             std::string t; t.reserve(tok.size());
             for (char c : tok) t.push_back((char)std::tolower((unsigned char)c));
+            if (t == "ns" || t == "nanosecond" || t == "nanoseconds") return Precision::Nanoseconds;
+            if (t == "us" || t == "\xC2\xB5s" || t == "microsecond" || t == "microseconds") return Precision::Microseconds;
             if (t == "ms" || t == "millisecond" || t == "milliseconds") return Precision::Milliseconds;
             if (t == "s"  || t == "sec" || t == "secs" || t == "second" || t == "seconds") return Precision::Seconds;
             if (t == "m"  || t == "min" || t == "mins"  || t == "minute" || t == "minutes") return Precision::Minutes;
@@ -403,22 +537,6 @@ static inline std::string formatDuration(ns_t ns, const FormatOptions& opts = {}
             return Precision::Milliseconds;
         }
 
-        // convert ns -> chosen unit (double, fractional)
-        static double toUnits(std::chrono::nanoseconds ns, Precision p) {
-            const long double n = (long double)ns.count();
-            switch (p) {
-                case Precision::Milliseconds: return (double)(n / NS_IN_MS);
-                case Precision::Seconds:      return (double)(n / NS_IN_S);
-                case Precision::Minutes:      return (double)(n / MIN_NS);
-                case Precision::Hours:        return (double)(n / HOUR_NS);
-                case Precision::Days:         return (double)(n / DAY_NS);
-                case Precision::Weeks:        return (double)(n / WEEK_NS);
-                case Precision::Months:       return (double)(n / MONTH_NS);
-                case Precision::Years:        return (double)(n / YEAR_NS);
-            }
-            return 0.0;
-        }
-
     private:
         Precision precision_;
         bool running_;
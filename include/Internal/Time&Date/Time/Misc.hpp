@@ -1,24 +1,12 @@
 #pragma once
 
 #include "Time.hpp"
+#include "../Clock/Clock.hpp"
 #include <string>
-#include <iomanip>
 
 namespace MF::Chrono::Time {
-    static std::string GetTimeStr() {
-        std::time_t t = GetRawTime();
-        std::tm tm_local;
-
-        #ifdef _WIN32
-            localtime_s(&tm_local, &t);
-        #else
-            localtime_r(&t, &tm_local);
-        #endif
-
-        std::ostringstream oss;
-        oss << std::setw(2) << std::setfill('0') << tm_local.tm_hour << ":"
-            << std::setw(2) << std::setfill('0') << tm_local.tm_min << ":"
-            << std::setw(2) << std::setfill('0') << tm_local.tm_sec;
-        return oss.str();
+    // local "HH:MM:SS", taken for every Print::Out line; formatted once per second (Clock.hpp)
+    inline std::string GetTimeStr() {
+        return Clock::TimeStr();
     }
 }
\ No newline at end of file
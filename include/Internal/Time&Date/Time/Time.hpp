@@ -3,7 +3,7 @@
 #include <ctime>
 
 namespace MF::Chrono::Time {
-    static std::time_t GetRawTime() {
+    inline std::time_t GetRawTime() {
         return std::time(nullptr);
     }
 }
\ No newline at end of file
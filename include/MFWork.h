@@ -6,5 +6,10 @@
 #include "./Internal/Files/FilesManager.hpp"
 #include "./Internal/Initialization/Initialize.hpp"
 #include "./Internal/Time&Date/Misc.hpp"
+#include "./Internal/Time&Date/CycleTimer.hpp"
+#include "./Internal/Time&Date/Histogram.hpp"
+#include "./Internal/Time&Date/Format/Format.hpp"
+#include "./Internal/Time&Date/Clock/Clock.hpp"
+#include "./Internal/Runtime/Scheduler/Scheduler.hpp"
 #include "./Internal/GUI/Foundation/Base.hpp"
 #include "./Internal/Settings/IntSettings.hpp"
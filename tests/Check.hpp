@@ -0,0 +1,19 @@
+#pragma once
+
+#include <cstdio>
+
+// CHECK records a failure and carries on; main returns MF_TEST_RESULT()
+inline int& mfTestFailures() {
+    static int failures = 0;
+    return failures;
+}
+
+#define CHECK(cond)                                                                     \
+    do {                                                                                \
+        if (!(cond)) {                                                                  \
+            std::fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #cond); \
+            ++mfTestFailures();                                                         \
+        }                                                                               \
+    } while (0)
+
+#define MF_TEST_RESULT() (mfTestFailures() == 0 ? 0 : 1)
@@ -0,0 +1,59 @@
+// ConfigManager with includes: the merged tree is never written over the files it came from
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include "Internal/Configuration/ConfigManager.hpp"
+#include "Check.hpp"
+
+using MF::Configurations::ConfigManager;
+
+static void writeFile(const std::string& name, const char* text) {
+    std::ofstream(name, std::ios::binary) << text;
+}
+
+static std::string readFile(const std::string& name) {
+    std::ifstream in(name, std::ios::binary);
+    std::stringstream text;
+    text << in.rdbuf();
+    return text.str();
+}
+
+int main() {
+    const char* mainText = "App:\n    include: fragment.hc\n    Port: 8080\n";
+    const char* fragmentText = "Name: demo\n";
+    writeFile("includes_main.hc", mainText);
+    writeFile("fragment.hc", fragmentText);
+    std::string absolute = std::filesystem::absolute("includes_main.hc").string();
+
+    ConfigManager cfg;
+    CHECK(cfg.LoadWithIncludes("includes_main.hc"));
+    CHECK(cfg.GetString("App.Name") == "demo");
+
+    // every spelling of the main file, and the fragment, are refused
+    CHECK(!cfg.Save());
+    CHECK(!cfg.Save("./includes_main.hc"));
+    CHECK(!cfg.Save(absolute));
+    CHECK(!cfg.Save("fragment.hc"));
+    CHECK(!cfg.Save("./fragment.hc"));
+    CHECK(readFile("includes_main.hc") == mainText);
+    CHECK(readFile("fragment.hc") == fragmentText);
+
+    // a saving Set fails without touching the tree; an in-memory one goes through
+    CHECK(!cfg.Set("App.Port", 9090));
+    CHECK(cfg.GetInt("App.Port", -1) == 8080);
+    CHECK(cfg.Set("App.Port", 9090, false));
+    CHECK(cfg.GetInt("App.Port", -1) == 9090);
+    CHECK(readFile("includes_main.hc") == mainText);
+
+    // anywhere else the merged tree can be written
+    CHECK(cfg.Save("includes_flat.hc"));
+    ConfigManager flat;
+    CHECK(flat.Load("includes_flat.hc"));
+    CHECK(flat.GetString("App.Name") == "demo");
+    CHECK(flat.GetInt("App.Port", -1) == 9090);
+
+    for (const char* name : {"includes_main.hc", "fragment.hc", "includes_flat.hc"}) std::remove(name);
+    return MF_TEST_RESULT();
+}
@@ -0,0 +1,72 @@
+// ConfigManager: lazy loads under overrides, and copies of lazy / overridden configs
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include "Internal/Configuration/ConfigManager.hpp"
+#include "Check.hpp"
+
+using MF::Configurations::ConfigManager;
+using MF::Configurations::Internal::Parser::HCLayer;
+
+static void setVariable(const char* name, const char* value) {
+#ifdef _WIN32
+    _putenv_s(name, value);
+#else
+    setenv(name, value, 1);
+#endif
+}
+
+static std::string writeConfig(const char* name, const char* text) {
+    std::ofstream(name, std::ios::binary) << text;
+    return name;
+}
+
+int main() {
+    std::string file = writeConfig("lazy_test.hc",
+                                   "App:\n"
+                                   "    Port: 8080\n"
+                                   "    Name: demo\n"
+                                   "Db:\n"
+                                   "    Host: localhost\n");
+    setVariable("MF_CFG__App__Name", "fromenv");
+
+    // overrides first, then a lazy load: the file keys must still be there
+    {
+        ConfigManager cfg;
+        cfg.ApplyOverrides();
+        CHECK(cfg.LoadLazy(file));
+        CHECK(cfg.Has("App.Port"));
+        CHECK(cfg.GetInt("App.Port", -1) == 8080);
+        CHECK(cfg.GetString("Db.Host") == "localhost");
+        CHECK(cfg.GetString("App.Name") == "fromenv");
+        CHECK(cfg.SourceOf("App.Name") == HCLayer::Environment);
+        CHECK(cfg.SourceOf("App.Port") == HCLayer::File);
+    }
+
+    // a lazy load copied before anything was parsed
+    {
+        ConfigManager cfg;
+        CHECK(cfg.LoadLazy(file));
+        ConfigManager copy = cfg;
+        CHECK(copy.GetInt("App.Port", -1) == 8080);
+        CHECK(cfg.GetInt("App.Port", -1) == 8080);
+        CHECK(copy.Set("App.Port", 9090, false));
+        CHECK(copy.GetInt("App.Port", -1) == 9090);
+        CHECK(cfg.GetInt("App.Port", -1) == 8080);
+    }
+
+    // a copy of an overridden config has its own resolved view
+    {
+        ConfigManager cfg;
+        CHECK(cfg.Load(file));
+        cfg.ApplyOverrides();
+        ConfigManager copy;
+        copy = cfg;
+        cfg = ConfigManager();
+        CHECK(copy.GetString("App.Name") == "fromenv");
+        CHECK(copy.GetInt("App.Port", -1) == 8080);
+    }
+
+    std::remove(file.c_str());
+    return MF_TEST_RESULT();
+}
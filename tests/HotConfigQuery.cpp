@@ -0,0 +1,33 @@
+// HCQuery: editing through Run(HCMap&) stays inside the tree it ran on
+#include <string>
+#include <utility>
+#include "Internal/Configuration/Query.hpp"
+#include "Check.hpp"
+
+using namespace MF::Configurations::Internal::Parser;
+
+int main() {
+    HotConfig a;
+    CHECK(a.parseBuffer("Ports:\n    - 80\n    - 443\n"));
+    CHECK(a.root[0].second.asArray() != nullptr);
+    HotConfig b = a;
+
+    auto query = HCQuery::Compile("Ports[0]");
+    CHECK(query.has_value());
+    auto matches = query->Run(a.root);
+    CHECK(matches.size() == 1);
+    *matches[0] = HCValue(std::string("9999"));
+    a.root[0].second.invalidateHash();
+
+    // the copy still reads the compact array, and both views of `a` agree
+    CHECK(b.get("Ports")->asList()[0].asString() == "80");
+    CHECK(std::as_const(a.root[0].second).asList()[0].asString() == "9999");
+    CHECK(query->Run(std::as_const(a.root))[0]->asString() == "9999");
+
+    // `**` over a mutable tree reaches the expanded elements, once each
+    auto all = HCQuery::Compile("**.Ports[*]");
+    CHECK(all && all->Run(b.root).size() == 2);
+    CHECK(a.get("Ports") && b.get("Ports") && b.get("Ports")->asList()[0].asString() == "80");
+
+    return MF_TEST_RESULT();
+}
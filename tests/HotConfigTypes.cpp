@@ -0,0 +1,29 @@
+// HCValue: getType() names the alternative typed() returns
+#include <string>
+#include <variant>
+#include "Internal/Configuration/ConfigManager.hpp"
+#include "Check.hpp"
+
+using namespace MF::Configurations::Internal::Parser;
+
+int main() {
+    HotConfig config;
+    CHECK(config.parseBuffer("Small: 42\n"
+                             "Limit: 3000000000\n"
+                             "Negative: -3000000000\n"
+                             "Min: -2147483648\n"
+                             "Ratio: 0.5\n"));
+
+    for (const auto& [key, val] : config.root) {
+        ValType typed = val.typed();
+        std::string type = val.getType();
+        CHECK(type == "int" || type == "double");
+        if (type == "int") CHECK(std::holds_alternative<int>(typed));
+        if (type == "double") CHECK(std::holds_alternative<double>(typed));
+    }
+    CHECK(config.get("Limit")->getType() == "double");
+    CHECK(std::get<double>(config.get("Limit")->typed()) == 3000000000.0);
+    CHECK(config.get("Min")->getType() == "int");
+
+    return MF_TEST_RESULT();
+}
@@ -0,0 +1,44 @@
+// HCVersions: a commit after an edit that only touched comments keeps the new comments
+#include <string>
+#include "Internal/Configuration/Persistent.hpp"
+#include "Check.hpp"
+
+using namespace MF::Configurations::Internal::Parser;
+
+int main() {
+    HotConfig config;
+    CHECK(config.parseBuffer("Server:\n"
+                             "    Port: 80\n"
+                             "    Hosts:\n"
+                             "        - a\n"
+                             "        - b\n"
+                             "Db:\n"
+                             "    Host: x\n"));
+    HCValue& server = config.root[0].second;
+    server.CommentsBefore = {"# server"};
+    server.asMap()[0].second.InlineComment = "# http";
+    HCVersions history;
+    std::uint64_t first = history.Commit(config.root);
+
+    server.CommentsBefore = {"# web server"};
+    server.asMap()[0].second.InlineComment = "# https soon";
+    std::uint64_t second = history.Commit(config.root);
+
+    HCMap restored = history.At(second)->toMap();
+    CHECK(restored[0].second.CommentsBefore == std::vector<std::string>{"# web server"});
+    CHECK(restored[0].second.asMap()[0].second.InlineComment == "# https soon");
+    HCMap old = history.At(first)->toMap();
+    CHECK(old[0].second.CommentsBefore == std::vector<std::string>{"# server"});
+    CHECK(old[0].second.asMap()[0].second.InlineComment == "# http");
+
+    // what didn't change is still shared with the previous version
+    auto a = history.At(first)->node("Db");
+    auto b = history.At(second)->node("Db");
+    CHECK(a && a == b);
+    auto hostsA = history.At(first)->node("Server.Hosts");
+    auto hostsB = history.At(second)->node("Server.Hosts");
+    CHECK(hostsA && hostsA == hostsB);
+    CHECK(history.At(first)->node("Server") != history.At(second)->node("Server"));
+
+    return MF_TEST_RESULT();
+}
@@ -0,0 +1,50 @@
+// TimerWheel: a periodic timer fires once after the wheel wasn't advanced for many periods, then
+// keeps its cadence
+#include <chrono>
+#include "Internal/Runtime/Scheduler/Scheduler.hpp"
+#include "Check.hpp"
+
+using MF::Runtime::TimerWheel;
+using std::chrono::milliseconds;
+using std::chrono::seconds;
+
+int main() {
+    const auto origin = TimerWheel::Clock::now();
+
+    // 10 ms timer, 10 s gap
+    {
+        TimerWheel wheel(milliseconds(1), origin);
+        int runs = 0;
+        auto id = wheel.ScheduleAt(origin + milliseconds(10), [&] { ++runs; }, milliseconds(10));
+        CHECK(wheel.Advance(origin + milliseconds(10)) == 1);
+        CHECK(wheel.Advance(origin + seconds(10) + milliseconds(5)) == 1);
+        CHECK(runs == 2);
+        CHECK(wheel.Expiry(id) == origin + seconds(10) + milliseconds(10));
+        CHECK(wheel.Advance(origin + seconds(10) + milliseconds(9)) == 0);
+        CHECK(wheel.Advance(origin + seconds(10) + milliseconds(10)) == 1);
+        CHECK(wheel.Advance(origin + seconds(10) + milliseconds(30)) == 1);
+        CHECK(runs == 4);
+    }
+
+    // 1 ms timer, 300 ms stall; a gap ending exactly on a deadline skips that one too
+    {
+        TimerWheel wheel(milliseconds(1), origin);
+        int runs = 0;
+        auto id = wheel.ScheduleAt(origin + milliseconds(1), [&] { ++runs; }, milliseconds(1));
+        CHECK(wheel.Advance(origin + milliseconds(300)) == 1);
+        CHECK(wheel.Expiry(id) == origin + milliseconds(301));
+        for (int ms = 301; ms <= 310; ++ms) wheel.Advance(origin + milliseconds(ms));
+        CHECK(runs == 11);
+    }
+
+    // stepping tick by tick loses nothing
+    {
+        TimerWheel wheel(milliseconds(1), origin);
+        int runs = 0;
+        wheel.ScheduleAt(origin + milliseconds(3), [&] { ++runs; }, milliseconds(3));
+        for (int ms = 0; ms <= 3000; ++ms) wheel.Advance(origin + milliseconds(ms));
+        CHECK(runs == 1000);
+    }
+
+    return MF_TEST_RESULT();
+}